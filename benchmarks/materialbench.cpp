@@ -0,0 +1,290 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Per-point cost of updateCurrentState, stress, tangent and commitCurrentState for every material that is registered
+// in smallstrainbindings.cpp and finitestrainbindings.cpp.
+//
+// Usage: jlmuesli_bench [--json] [--filter=<material>] [points] [steps]
+//
+// Each material is driven along two paths: "elastic" stays at half the yield strain, "plastic" goes to five times the
+// yield strain (for the hyperelastic models this is simply the large strain path). The points are stored in a
+// MaterialPointArena and evaluated serially, so the numbers are the cost of muesli itself. julia/benchmark.jl runs
+// the same operations through the CxxWrap layer and prints the same columns.
+//
+// Output is CSV (material,path,operation,points,steps,ns_per_point) or, with --json, a JSON array of the same records.
+
+#include <jlmuesli/util/mparena.hh>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <muesli/Finitestrain/fplastic.h>
+#include <muesli/Finitestrain/reducedfinitestrain.h>
+#include <muesli/Smallstrain/sdamage.h>
+#include <muesli/muesli.h>
+
+namespace {
+constexpr double E     = 210000.0;
+constexpr double nu    = 0.3;
+constexpr double rho   = 1.0;
+constexpr double yield = 250.0;
+constexpr double G     = E / (2.0 * (1.0 + nu));
+constexpr double K     = E / (3.0 * (1.0 - 2.0 * nu));
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+  std::size_t points = 10000;
+  std::size_t steps  = 10;
+  bool json          = false;
+  std::string filter;
+};
+
+struct Record
+{
+  std::string material;
+  std::string path;
+  std::string operation;
+  double nsPerPoint;
+};
+
+struct Path
+{
+  const char* name;
+  double amplitude;
+};
+
+constexpr Path paths[] = {
+    {"elastic", 0.5 * yield / E},
+    {"plastic", 5.0 * yield / E}
+};
+
+// Keeps the compiler from dropping the evaluations
+volatile double sink = 0.0;
+
+// Times the four operations over all points for one path. Update(mp, t, x) drives a point to the load level x.
+template <typename MaterialPoint, typename Material, typename Update, typename Stress, typename Tangent>
+void timePath(const Options& options, const std::string& name, const Path& path, const Material& material,
+              Update&& update, Stress&& stress, Tangent&& tangent, std::vector<Record>& records) {
+  MaterialPointArena<MaterialPoint> points(material, options.points);
+  Clock::duration elapsed[4] = {};
+  double checksum            = 0.0;
+
+  for (std::size_t step = 1; step <= options.steps; ++step) {
+    const double t = static_cast<double>(step) / static_cast<double>(options.steps);
+
+    auto start = Clock::now();
+    for (auto& mp : points)
+      update(mp, t, t * path.amplitude);
+    elapsed[0] += Clock::now() - start;
+
+    start = Clock::now();
+    for (auto& mp : points)
+      checksum += stress(mp);
+    elapsed[1] += Clock::now() - start;
+
+    start = Clock::now();
+    for (auto& mp : points)
+      checksum += tangent(mp);
+    elapsed[2] += Clock::now() - start;
+
+    start = Clock::now();
+    for (auto& mp : points)
+      mp.commitCurrentState();
+    elapsed[3] += Clock::now() - start;
+  }
+  sink = sink + checksum;
+
+  const char* operations[4] = {"update", "stress", "tangent", "commit"};
+  const double evaluations  = static_cast<double>(options.points * options.steps);
+  for (std::size_t op = 0; op < 4; ++op)
+    records.push_back({name, path.name, operations[op],
+                       std::chrono::duration<double, std::nano>(elapsed[op]).count() / evaluations});
+}
+
+// Uniaxial strain with a small shear component
+istensor strainAt(double x) { return istensor(x, -0.3 * x, -0.3 * x, 0.0, 0.0, 0.2 * x); }
+
+itensor deformationAt(double x) {
+  return itensor(1.0 + x, 0.2 * x, 0.0,  // Row 1
+                 0.0, 1.0 - 0.3 * x, 0.0, // Row 2
+                 0.0, 0.0, 1.0 - 0.3 * x  // Row 3
+  );
+}
+
+template <typename MaterialPoint, typename Material>
+void benchSmallStrain(const Options& options, const std::string& name, const Material& material,
+                      std::vector<Record>& records) {
+  if (!options.filter.empty() && options.filter != name)
+    return;
+  istensor sigma;
+  itensor4 C;
+  for (const auto& path : paths)
+    timePath<MaterialPoint>(
+        options, name, path, material,
+        [](MaterialPoint& mp, double t, double x) { mp.updateCurrentState(t, strainAt(x)); },
+        [&](const MaterialPoint& mp) {
+          mp.stress(sigma);
+          return sigma(0, 0);
+        },
+        [&](const MaterialPoint& mp) {
+          mp.tangentTensor(C);
+          return C(0, 0, 0, 0);
+        },
+        records);
+}
+
+template <typename MaterialPoint, typename Material>
+void benchFiniteStrain(const Options& options, const std::string& name, const Material& material,
+                       std::vector<Record>& records) {
+  if (!options.filter.empty() && options.filter != name)
+    return;
+  istensor S;
+  itensor4 C;
+  for (const auto& path : paths)
+    timePath<MaterialPoint>(
+        options, name, path, material,
+        [](MaterialPoint& mp, double t, double x) { mp.updateCurrentState(t, deformationAt(x)); },
+        [&](const MaterialPoint& mp) {
+          mp.secondPiolaKirchhoffStress(S);
+          return S(0, 0);
+        },
+        [&](const MaterialPoint& mp) {
+          mp.convectedTangent(C);
+          return C(0, 0, 0, 0);
+        },
+        records);
+}
+
+void benchSmallStrainMaterials(const Options& options, std::vector<Record>& records) {
+  using namespace muesli;
+
+  benchSmallStrain<elasticIsotropicMP>(options, "ElasticIsotropic",
+                                       elasticIsotropicMaterial{"ElasticIsotropic", E, nu, rho}, records);
+
+  // Isotropic stiffness in the anisotropic and orthotropic parametrizations
+  const double lambda = K - 2.0 / 3.0 * G;
+  double c21[21]      = {};
+  for (std::size_t i = 0, a = 0; a < 6; ++a)
+    for (std::size_t b = a; b < 6; ++b, ++i)
+      c21[i] = a == b ? (a < 3 ? lambda + 2.0 * G : G) : (a < 3 && b < 3 ? lambda : 0.0);
+  benchSmallStrain<elasticAnisotropicMP>(options, "ElasticAnisotropic",
+                                         elasticAnisotropicMaterial{"ElasticAnisotropic", c21, rho}, records);
+
+  const double c9[9] = {E, E, E, nu, nu, nu, G, G, G};
+  benchSmallStrain<elasticOrthotropicMP>(options, "ElasticOrthotropic",
+                                         elasticOrthotropicMaterial{"ElasticOrthotropic", c9, rho}, records);
+
+  const double c6[6] = {E, E, nu, nu, G, G};
+  benchSmallStrain<elasticTransverselyisotropicMP>(
+      options, "ElasticTransverselyisotropic",
+      elasticTransverselyisotropicMaterial{"ElasticTransverselyisotropic", c6, rho}, records);
+
+  benchSmallStrain<splasticMP>(options, "Splastic",
+                               splasticMaterial{"Splastic", E, nu, rho, 1000.0, 0.0, yield, 0.0, "mises"}, records);
+
+  double eta[2] = {0.5 * E, 0.25 * E};
+  double tau[2] = {0.1, 1.0};
+  benchSmallStrain<viscoelasticMP>(options, "Viscoelastic",
+                                   viscoelasticMaterial{"Viscoelastic", E, nu, rho, std::size_t{2}, eta, tau}, records);
+
+  benchSmallStrain<viscoplasticMP>(
+      options, "Viscoplastic",
+      viscoplasticMaterial{"Viscoplastic", E, nu, rho, 1000.0, 0.0, yield, "mises", 1.0e-3, 1.0}, records);
+
+  benchSmallStrain<GTN_MP>(options, "GTN", GTN_Material{"GTN", E, nu, rho, 1.5, 1.0, yield}, records);
+  benchSmallStrain<Gurson_MP>(options, "Gurson", Gurson_Material{"Gurson", E, nu, rho, 100.0, 10.0, yield}, records);
+  benchSmallStrain<Lemaitre_MP>(options, "Lemaitre",
+                                Lemaitre_Material{"Lemaitre", E, nu, rho, 1.0, 1.0, yield, 100.0, 10.0}, records);
+  benchSmallStrain<LemKin_MP>(options, "LemKin",
+                              LemKin_Material{"LemKin", E, nu, rho, 1.0, 1.0, yield, 100.0, 10.0, 1000.0, 10.0},
+                              records);
+}
+
+void benchFiniteStrainMaterials(const Options& options, std::vector<Record>& records) {
+  using namespace muesli;
+
+  benchFiniteStrain<neohookeanMP>(options, "NeoHooke", neohookeanMaterial{"NeoHooke", E, nu, rho}, records);
+
+  const materialProperties svk{
+      {  "young",  E},
+      {"poisson", nu}
+  };
+  benchFiniteStrain<svkMP>(options, "SVK", svkMaterial{"SVK", svk}, records);
+
+  const materialProperties mooney{
+      {"alpha0",       0.0},
+      {"alpha1", 0.4 * G},
+      {"alpha2", 0.1 * G}
+  };
+  benchFiniteStrain<mooneyMP>(options, "Mooney", mooneyMaterial{"Mooney", mooney}, records);
+
+  benchFiniteStrain<arrudaboyceMP>(options, "ArrudaBoyce", arrudaboyceMaterial{"ArrudaBoyce", 0.5 * G, 3.0, K, true},
+                                   records);
+  benchFiniteStrain<yeohMP>(options, "Yeoh", yeohMaterial{"Yeoh", 0.5 * G, G / 6.0, G / 3.0, K, true}, records);
+
+  const materialProperties fplastic{
+      {      "young",      E},
+      {    "poisson",     nu},
+      { "isotropich", 1000.0},
+      { "kinematich",    0.0},
+      {"yieldstress",  yield},
+      {   "yieldinf",  yield},
+      {    "hardexp",    0.0},
+      {  "softening",    0.0}
+  };
+  benchFiniteStrain<fplasticMP>(options, "Fplastic", fplasticMaterial{"Fplastic", fplastic}, records);
+}
+
+Options parseOptions(int argc, char** argv) {
+  Options options;
+  std::size_t positional = 0;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--json")
+      options.json = true;
+    else if (arg.rfind("--filter=", 0) == 0)
+      options.filter = arg.substr(std::strlen("--filter="));
+    else if (positional++ == 0)
+      options.points = std::strtoul(argv[i], nullptr, 10);
+    else
+      options.steps = std::strtoul(argv[i], nullptr, 10);
+  }
+  return options;
+}
+
+void print(const Options& options, const std::vector<Record>& records) {
+  if (!options.json) {
+    std::cout << "material,path,operation,points,steps,ns_per_point\n";
+    for (const auto& r : records)
+      std::cout << r.material << ',' << r.path << ',' << r.operation << ',' << options.points << ',' << options.steps
+                << ',' << r.nsPerPoint << '\n';
+    return;
+  }
+
+  std::cout << "[\n";
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    const auto& r = records[i];
+    std::cout << "  {\"material\": \"" << r.material << "\", \"path\": \"" << r.path << "\", \"operation\": \""
+              << r.operation << "\", \"points\": " << options.points << ", \"steps\": " << options.steps
+              << ", \"ns_per_point\": " << r.nsPerPoint << '}' << (i + 1 < records.size() ? "," : "") << '\n';
+  }
+  std::cout << "]\n";
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  const Options options = parseOptions(argc, argv);
+
+  std::vector<Record> records;
+  benchSmallStrainMaterials(options, records);
+  benchFiniteStrainMaterials(options, records);
+  print(options, records);
+
+  return 0;
+}
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Agreement and speed of the vectorized batch kernels (simdkernels.hh) against the muesli path.
+//
+// Usage: jlmuesli_simdcheck [points] [steps]
+//
+// The isotropic elastic, Neo-Hookean and Saint Venant-Kirchhoff batches are evaluated on random strains (deformation
+// gradients) once with the kernel and once through muesli. The CSV output lists the largest deviation of stress,
+// tangent and energy relative to the largest muesli value, and the time of both paths. The exit code is nonzero if a
+// kernel was not verified at construction or deviates by more than round-off.
+
+#include <jlmuesli/finitestrain/finitestrainbatch.hh>
+#include <jlmuesli/smallstrain/smallstrainbatch.hh>
+#include <jlmuesli/util/simdkernels.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <muesli/muesli.h>
+
+constexpr double E         = 210000.0;
+constexpr double nu        = 0.3;
+constexpr double rho       = 1.0;
+constexpr double tolerance = 1.0e-12;
+
+struct Output
+{
+  std::vector<double> stress, tangent, energy;
+};
+
+double deviation(const std::vector<double>& kernel, const std::vector<double>& reference) {
+  double scale = 0.0, error = 0.0;
+  for (std::size_t m = 0; m < reference.size(); ++m) {
+    scale = std::max(scale, std::abs(reference[m]));
+    error = std::max(error, std::abs(kernel[m] - reference[m]));
+  }
+  return scale > 0.0 ? error / scale : error;
+}
+
+// Evaluates the batch on the given input with and without the kernel and prints one CSV line, returns whether the
+// kernel agreed with muesli
+template <typename Batch>
+bool compare(const std::string& model, Batch& batch, const std::vector<double>& input, std::size_t components,
+             std::size_t steps) {
+  const std::size_t n = batch.size();
+  const bool verified = batch.simdKernel();
+
+  const auto run = [&](bool kernel, Output& out) {
+    if (verified)
+      batch.setSimdKernel(kernel);
+    out.stress.resize(components * n);
+    out.tangent.resize(81 * n);
+    out.energy.resize(n);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t step = 1; step <= steps; ++step)
+      batch.evaluate(static_cast<double>(step), input.data(), out.stress.data(), components, out.tangent.data(),
+                     TangentLayout::Full, out.energy.data());
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  };
+
+  Output reference, kernel;
+  const double muesliSeconds = run(false, reference);
+  const double kernelSeconds = run(true, kernel);
+
+  const double stressError  = deviation(kernel.stress, reference.stress);
+  const double tangentError = deviation(kernel.tangent, reference.tangent);
+  const double energyError  = deviation(kernel.energy, reference.energy);
+  const bool agrees         = verified && std::max({stressError, tangentError, energyError}) < tolerance;
+
+  std::cout << model << ',' << simdInstructionSet() << ',' << (verified ? "true" : "false") << ',' << n << ','
+            << steps << ',' << muesliSeconds << ',' << kernelSeconds << ',' << muesliSeconds / kernelSeconds << ','
+            << stressError << ',' << tangentError << ',' << energyError << '\n';
+  return agrees;
+}
+
+int main(int argc, char** argv) {
+  const std::size_t points = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+  const std::size_t steps  = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10;
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> perturbation(-0.1, 0.1);
+
+  std::cout << "model,isa,verified,points,steps,muesli_seconds,kernel_seconds,speedup,stress_error,tangent_error,"
+               "energy_error\n";
+
+  muesli::elasticIsotropicMaterial elastic{"ElasticIsotropic", E, nu, rho};
+  SmallStrainMPBatch<muesli::elasticIsotropicMaterial, muesli::elasticIsotropicMP> elasticBatch(elastic, points);
+  std::vector<double> strain(6 * points);
+  for (auto& e : strain)
+    e = 1.0e-2 * perturbation(generator);
+  bool agrees = compare("ElasticIsotropic", elasticBatch, strain, 6, steps);
+
+  muesli::neohookeanMaterial neohookean{"NeoHooke", E, nu, rho};
+  FiniteStrainMPBatch<muesli::neohookeanMaterial, muesli::neohookeanMP> neohookeanBatch(neohookean, points);
+  std::vector<double> F(9 * points);
+  for (std::size_t i = 0; i < points; ++i)
+    for (std::size_t k = 0; k < 9; ++k)
+      F[9 * i + k] = (k % 4 == 0 ? 1.0 : 0.0) + perturbation(generator);
+  agrees = compare("NeoHooke", neohookeanBatch, F, 9, steps) && agrees;
+
+  muesli::svkMaterial svk{"SVK", muesli::materialProperties{{"young", E}, {"poisson", nu}}};
+  FiniteStrainMPBatch<muesli::svkMaterial, muesli::svkMP> svkBatch(svk, points);
+  agrees = compare("SVK", svkBatch, F, 9, steps) && agrees;
+
+  return agrees ? 0 : 1;
+}
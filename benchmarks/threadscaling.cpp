@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Thread scaling of the batched evaluation for the plastic models splastic and fplastic.
+//
+// Usage: jlmuesli_threadscaling [points] [steps] [maxThreads]
+//
+// Every fourth point is driven well beyond the yield point, the others stay elastic, so the cost per point is uneven.
+// The run is repeated for 1, 2, 4, ... threads up to maxThreads and printed as CSV. The column `identical` compares
+// the final stresses bitwise against the single threaded run, the exit code is nonzero if any run differs.
+
+#include <jlmuesli/finitestrain/finitestrainbatch.hh>
+#include <jlmuesli/smallstrain/smallstrainbatch.hh>
+#include <jlmuesli/util/threadpool.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <muesli/Finitestrain/fplastic.h>
+#include <muesli/muesli.h>
+
+struct Result
+{
+  double seconds;
+  std::vector<double> stress;
+};
+
+constexpr double E     = 210000.0;
+constexpr double nu    = 0.3;
+constexpr double yield = 250.0;
+
+// Uniaxial strain ramp, every fourth point reaches five times the yield strain
+double amplitude(std::size_t point) { return (point % 4 == 0 ? 5.0 : 0.5) * yield / E; }
+
+Result runSplastic(std::size_t points, std::size_t steps) {
+  muesli::splasticMaterial material{"Splastic", E, nu, 1.0, 1000.0, 0.0, yield, 0.0, "mises"};
+  SmallStrainMPBatch<muesli::splasticMaterial, muesli::splasticMP> batch(material, points);
+
+  std::vector<double> strain(6 * points, 0.0), stress(6 * points), C(36 * points), energy(points);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t step = 1; step <= steps; ++step) {
+    const double t = static_cast<double>(step) / static_cast<double>(steps);
+    for (std::size_t i = 0; i < points; ++i)
+      strain[6 * i] = t * amplitude(i);
+    batch.evaluate(t, strain.data(), stress.data(), 6, C.data(), TangentLayout::Voigt, energy.data());
+    batch.commitCurrentState();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return {elapsed.count(), stress};
+}
+
+Result runFplastic(std::size_t points, std::size_t steps) {
+  muesli::materialProperties properties{
+      {      "young",      E},
+      {    "poisson",     nu},
+      { "isotropich", 1000.0},
+      { "kinematich",    0.0},
+      {"yieldstress",  yield},
+      {   "yieldinf",  yield},
+      {    "hardexp",    0.0},
+      {  "softening",    0.0}
+  };
+  muesli::fplasticMaterial material{"Fplastic", properties};
+  FiniteStrainMPBatch<muesli::fplasticMaterial, muesli::fplasticMP> batch(material, points);
+
+  std::vector<double> F(9 * points, 0.0), S(6 * points), C(36 * points), energy(points);
+  for (std::size_t i = 0; i < points; ++i)
+    F[9 * i] = F[9 * i + 4] = F[9 * i + 8] = 1.0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t step = 1; step <= steps; ++step) {
+    const double t = static_cast<double>(step) / static_cast<double>(steps);
+    for (std::size_t i = 0; i < points; ++i)
+      F[9 * i] = 1.0 + t * amplitude(i);
+    batch.evaluate(t, F.data(), S.data(), 6, C.data(), TangentLayout::Voigt, energy.data());
+    batch.commitCurrentState();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return {elapsed.count(), S};
+}
+
+int main(int argc, char** argv) {
+  const std::size_t points     = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+  const std::size_t steps      = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10;
+  const std::size_t maxThreads = argc > 3 ? std::strtoul(argv[3], nullptr, 10)
+                                          : std::min<std::size_t>(64, std::thread::hardware_concurrency());
+
+  std::cout << "model,threads,points,steps,seconds,speedup,identical\n";
+
+  bool allIdentical = true;
+  const auto scale  = [&](const std::string& model, Result (*run)(std::size_t, std::size_t)) {
+    Result serial;
+    for (std::size_t threads = 1; threads <= std::max<std::size_t>(maxThreads, 1); threads *= 2) {
+      ThreadPool::global().resize(threads);
+      Result result = run(points, steps);
+      if (threads == 1)
+        serial = result;
+      const bool identical = std::memcmp(result.stress.data(), serial.stress.data(),
+                                         result.stress.size() * sizeof(double)) == 0;
+      allIdentical = allIdentical && identical;
+      std::cout << model << ',' << threads << ',' << points << ',' << steps << ',' << result.seconds << ','
+                << serial.seconds / result.seconds << ',' << (identical ? "true" : "false") << '\n';
+    }
+  };
+
+  scale("splastic", &runSplastic);
+  scale("fplastic", &runFplastic);
+
+  return allIdentical ? 0 : 1;
+}
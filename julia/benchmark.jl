@@ -0,0 +1,126 @@
+# SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+# SPDX-License-Identifier: MIT
+
+# Per-point cost of updateCurrentState, stress, tangent and commitCurrentState through the CxxWrap layer. Runs the
+# same materials, load paths and operations as the native jlmuesli_bench target and prints the same CSV columns, so
+# the difference between the two is the binding overhead.
+#
+# Usage: julia benchmark.jl <path to lib> [points] [steps]
+
+module MuesliTest
+path_to_lib = "/workspaces/libjlmuesli/build/lib/"
+
+if (!isempty(ARGS))
+    path_to_lib = ARGS[1]
+end
+
+using CxxWrap
+@wrapmodule(()->joinpath(path_to_lib, "libjlmuesli"))
+
+function __init__()
+    @initcxx
+end
+
+end
+
+const points = length(ARGS) > 1 ? parse(Int, ARGS[2]) : 10000
+const steps  = length(ARGS) > 2 ? parse(Int, ARGS[3]) : 10
+
+const E     = 210000.0
+const ν     = 0.3
+const ρ     = 1.0
+const yield = 250.0
+const G     = E / (2 + 2ν)
+const K     = E / (3 * (1 - 2ν))
+
+const paths = ("elastic" => 0.5 * yield / E, "plastic" => 5.0 * yield / E)
+
+# Same load paths as benchmarks/materialbench.cpp
+strainAt(x) = [x 0.2x 0.0; 0.2x -0.3x 0.0; 0.0 0.0 -0.3x]
+deformationAt(x) = [1.0+x 0.2x 0.0; 0.0 1.0-0.3x 0.0; 0.0 0.0 1.0-0.3x]
+
+function isotropicVoigt()
+    λ = K - 2G / 3
+    C = zeros(6, 6)
+    C[1:3, 1:3] .= λ
+    for a in 1:3
+        C[a, a] += 2G
+        C[a + 3, a + 3] = G
+    end
+    [C[a, b] for a in 1:6 for b in a:6]
+end
+
+const smallStrainMaterials = [
+    "ElasticIsotropic"             => () -> MuesliTest.ElasticIsotropicMaterial(E, ν),
+    "ElasticAnisotropic"           => () -> MuesliTest.ElasticAnisotropicMaterial(isotropicVoigt(), ρ),
+    "ElasticOrthotropic"           => () -> MuesliTest.ElasticOrthotropicMaterial([E, E, E, ν, ν, ν, G, G, G], ρ),
+    "ElasticTransverselyisotropic" => () -> MuesliTest.ElasticTransverselyisotropicMaterial([E, E, ν, ν, G, G], ρ),
+    "Splastic"                     => () -> MuesliTest.SplasticMaterial(E, ν, ρ, 1000.0, 0.0, yield, 0.0, "mises"),
+    "Viscoelastic"                 => () -> MuesliTest.ViscoelasticMaterial(E, ν, ρ, UInt(2), [0.5E, 0.25E], [0.1, 1.0]),
+    "Viscoplastic"                 => () -> MuesliTest.ViscoplasticMaterial(E, ν, ρ, 1000.0, 0.0, yield, "mises", 1.0e-3,
+                                                                            1.0),
+    "GTN"                          => () -> MuesliTest.GTN_Material(E, ν, ρ, 1.5, 1.0, yield),
+    "Gurson"                       => () -> MuesliTest.Gurson_Material(E, ν, ρ, 100.0, 10.0, yield),
+    "Lemaitre"                     => () -> MuesliTest.Lemaitre_Material(E, ν, ρ, 1.0, 1.0, yield, 100.0, 10.0),
+    "LemKin"                       => () -> MuesliTest.LemKin_Material(E, ν, ρ, 1.0, 1.0, yield, 100.0, 10.0, 1000.0,
+                                                                       10.0)
+]
+
+const finiteStrainMaterials = [
+    "NeoHooke"    => () -> MuesliTest.NeoHookeMaterial(E, ν),
+    "SVK"         => () -> MuesliTest.SVKMaterial(E, ν),
+    "Mooney"      => () -> MuesliTest.MooneyMaterial(0.0, 0.4G, 0.1G, false),
+    "ArrudaBoyce" => () -> MuesliTest.ArrudaBoyceMaterial(0.5G, 3.0, K, true),
+    "Yeoh"        => () -> MuesliTest.YeohMaterial(0.5G, G / 6, G / 3, K, true),
+    "Fplastic"    => () -> MuesliTest.FplasticMaterial(E, ν, 1000.0, 0.0, yield, yield, 0.0, 0.0)
+]
+
+# Julia name of the material point type, e.g. GTN_MP for the material registered as "GTN_"
+mpType(name) = getproperty(MuesliTest, Symbol(name in ("GTN", "Gurson", "Lemaitre", "LemKin") ? name * "_MP" :
+                                              name * "MP"))
+
+function timePath(mps, amplitude, load, stress!, tangent!)
+    σ = zeros(3, 3)
+    ℂ = zeros(3, 3, 3, 3)
+    elapsed = zeros(4)
+    for step in 1:steps
+        t = step / steps
+        x = load(t * amplitude)
+        elapsed[1] += @elapsed for mp in mps
+            MuesliTest.updateCurrentState(mp, t, x)
+        end
+        elapsed[2] += @elapsed for mp in mps
+            stress!(mp, σ)
+        end
+        elapsed[3] += @elapsed for mp in mps
+            tangent!(mp, ℂ)
+        end
+        elapsed[4] += @elapsed for mp in mps
+            MuesliTest.commitCurrentState(mp)
+        end
+    end
+    elapsed .* 1.0e9 ./ (points * steps)
+end
+
+function bench(materials, load, stress!, tangent!)
+    for (name, create) in materials
+        mat = create()
+        MP = mpType(name)
+        for (path, amplitude) in paths
+            mps = [MP(mat) for _ in 1:points]
+            ns = timePath(mps, amplitude, load, stress!, tangent!)
+            for (operation, t) in zip(("update", "stress", "tangent", "commit"), ns)
+                println(join((name, path, operation, points, steps, t), ","))
+            end
+        end
+    end
+end
+
+# Warm up the method dispatch before measuring
+let mat = MuesliTest.ElasticIsotropicMaterial(E, ν), mp = MuesliTest.ElasticIsotropicMP(mat)
+    MuesliTest.updateCurrentState(mp, 0.0, strainAt(0.0))
+end
+
+println("material,path,operation,points,steps,ns_per_point")
+bench(smallStrainMaterials, strainAt, MuesliTest.stress!, MuesliTest.tangentTensor!)
+bench(finiteStrainMaterials, deformationAt, MuesliTest.secondPiolaKirchhoffStress!, MuesliTest.convectedTangent!)
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <jlmuesli/capi/jlmuesli.h>
+#include <jlmuesli/finitestrain/finitestrainbatch.hh>
+#include <jlmuesli/smallstrain/smallstrainbatch.hh>
+#include <jlmuesli/util/layout.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+// Implementation side of the opaque handles of jlmuesli.h. A batch handle either owns its batch (created through the
+// C API) or borrows one owned by Julia (capiHandle in the jlcxx module).
+struct jlmuesli_batch
+{
+  virtual ~jlmuesli_batch() = default;
+
+  virtual std::size_t size() const  = 0;
+  virtual bool finiteStrain() const = 0;
+
+  virtual void update(double t, const double* input, std::size_t components) = 0;
+  virtual void stress(double* out, std::size_t components) const              = 0;
+  virtual void tangent(double* out, TangentLayout layout) const               = 0;
+  virtual void energy(double* out) const                                      = 0;
+
+  virtual void evaluate(double t, const double* input, double* stress, std::size_t components, double* tangent,
+                        TangentLayout layout, double* energy) = 0;
+
+  virtual void commit() = 0;
+  virtual void reset()  = 0;
+
+  virtual void setStatusTracking(bool enabled) = 0;
+  virtual bool statusTracking() const          = 0;
+  virtual const unsigned char* status() const  = 0;
+
+  virtual void setSubstepping(std::size_t maxLevels, double incrementLimit) = 0;
+  virtual bool substepping() const                                          = 0;
+  virtual const std::uint32_t* substeps() const                             = 0;
+};
+
+struct jlmuesli_material
+{
+  virtual ~jlmuesli_material() = default;
+
+  virtual bool finiteStrain() const                                        = 0;
+  virtual std::unique_ptr<jlmuesli_batch> createBatch(std::size_t n) const = 0;
+};
+
+template <typename Batch>
+struct IsFiniteStrainBatch : std::false_type
+{};
+
+template <typename Material, typename MaterialPoint>
+struct IsFiniteStrainBatch<FiniteStrainMPBatch<Material, MaterialPoint>> : std::true_type
+{};
+
+template <typename Batch>
+class BatchHandle : public jlmuesli_batch
+{
+  static constexpr bool finite = IsFiniteStrainBatch<Batch>::value;
+
+public:
+  explicit BatchHandle(std::unique_ptr<Batch> batch)
+      : owned_(std::move(batch)),
+        batch_(*owned_) {}
+
+  explicit BatchHandle(Batch& batch)
+      : batch_(batch) {}
+
+  std::size_t size() const override { return batch_.size(); }
+  bool finiteStrain() const override { return finite; }
+
+  void update(double t, const double* input, std::size_t components) override {
+    if constexpr (finite)
+      batch_.updateCurrentState(t, input);
+    else
+      batch_.updateCurrentState(t, input, components);
+  }
+
+  void stress(double* out, std::size_t components) const override {
+    if constexpr (finite)
+      batch_.secondPiolaKirchhoffStress(out, components);
+    else
+      batch_.stress(out, components);
+  }
+
+  void tangent(double* out, TangentLayout layout) const override {
+    if constexpr (finite)
+      batch_.convectedTangent(out, layout);
+    else
+      batch_.tangentTensor(out, layout);
+  }
+
+  void energy(double* out) const override { batch_.storedEnergy(out); }
+
+  void evaluate(double t, const double* input, double* stress, std::size_t components, double* tangent,
+                TangentLayout layout, double* energy) override {
+    batch_.evaluate(t, input, stress, components, tangent, layout, energy);
+  }
+
+  void commit() override { batch_.commitCurrentState(); }
+  void reset() override { batch_.resetCurrentState(); }
+
+  void setStatusTracking(bool enabled) override { batch_.setStatusTracking(enabled); }
+  bool statusTracking() const override { return batch_.statusTracking(); }
+  const unsigned char* status() const override { return batch_.status().data(); }
+
+  void setSubstepping(std::size_t maxLevels, double incrementLimit) override {
+    batch_.setSubstepping(maxLevels, incrementLimit);
+  }
+  bool substepping() const override { return batch_.substepping(); }
+  const std::uint32_t* substeps() const override { return batch_.substeps().data(); }
+
+private:
+  std::unique_ptr<Batch> owned_;
+  Batch& batch_;
+};
+
+// Handle on a batch owned elsewhere, released with jlmuesli_batch_destroy
+template <typename Batch>
+jlmuesli_batch* borrowedBatchHandle(Batch& batch) {
+  return new BatchHandle<Batch>(batch);
+}
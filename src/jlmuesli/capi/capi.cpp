@@ -0,0 +1,281 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <jlmuesli/capi/batchhandle.hh>
+#include <jlmuesli/capi/jlmuesli.h>
+#include <jlmuesli/util/pointstatus.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <muesli/muesli.h>
+#include <muesli/Smallstrain/sdamage.h>
+
+namespace {
+
+thread_local std::string lastError;
+
+// Runs f and maps exceptions to status codes, nothing may propagate through the C boundary
+template <typename F>
+int guarded(F&& f) {
+  try {
+    f();
+    lastError.clear();
+    return JLMUESLI_OK;
+  } catch (const std::invalid_argument& e) {
+    lastError = e.what();
+    return JLMUESLI_INVALID_ARGUMENT;
+  } catch (const std::out_of_range& e) {
+    lastError = e.what();
+    return JLMUESLI_INVALID_ARGUMENT;
+  } catch (const std::logic_error& e) {
+    lastError = e.what();
+    return JLMUESLI_UNSUPPORTED;
+  } catch (const std::exception& e) {
+    lastError = e.what();
+    return JLMUESLI_ERROR;
+  } catch (...) {
+    lastError = "Unknown error.";
+    return JLMUESLI_ERROR;
+  }
+}
+
+template <typename T>
+T& checkedHandle(T* handle) {
+  if (handle == nullptr)
+    throw std::invalid_argument("Handle must not be null.");
+  return *handle;
+}
+
+void checkBuffer(const void* data, std::size_t length, std::size_t components, std::size_t n) {
+  if (data == nullptr)
+    throw std::invalid_argument("Buffer must not be null.");
+  if (length != components * n)
+    throw std::invalid_argument("Buffer length does not match the number of points.");
+}
+
+std::size_t symmetricComponents(std::size_t components) {
+  if (components != 6 && components != 9)
+    throw std::invalid_argument("Symmetric tensors have 6 or 9 components.");
+  return components;
+}
+
+TangentLayout tangentLayout(int layout) {
+  switch (layout) {
+    case JLMUESLI_TANGENT_FULL:
+      return TangentLayout::Full;
+    case JLMUESLI_TANGENT_VOIGT:
+      return TangentLayout::Voigt;
+    case JLMUESLI_TANGENT_PACKED:
+      return TangentLayout::Packed;
+    default:
+      throw std::invalid_argument("Unknown tangent layout.");
+  }
+}
+
+// Components of the kinematic input per point, deformation gradients are always full
+std::size_t inputComponents(const jlmuesli_batch& batch, std::size_t components) {
+  if (batch.finiteStrain() && components != 9)
+    throw std::invalid_argument("Deformation gradients have 9 components.");
+  return symmetricComponents(components);
+}
+
+template <typename Material, typename MaterialPoint, typename Batch>
+class MaterialHandle : public jlmuesli_material
+{
+public:
+  MaterialHandle(const std::string& model, const std::multimap<std::string, double>& properties)
+      : material_(model, properties) {}
+
+  bool finiteStrain() const override { return IsFiniteStrainBatch<Batch>::value; }
+
+  std::unique_ptr<jlmuesli_batch> createBatch(std::size_t n) const override {
+    return std::make_unique<BatchHandle<Batch>>(std::make_unique<Batch>(material_, n));
+  }
+
+private:
+  Material material_;
+};
+
+using MaterialFactory =
+    std::function<jlmuesli_material*(const std::string&, const std::multimap<std::string, double>&)>;
+
+template <typename Material, typename MaterialPoint, template <typename, typename> class Batch>
+MaterialFactory materialFactory() {
+  return [](const std::string& model, const std::multimap<std::string, double>& properties) -> jlmuesli_material* {
+    return new MaterialHandle<Material, MaterialPoint, Batch<Material, MaterialPoint>>(model, properties);
+  };
+}
+
+const std::map<std::string, MaterialFactory>& materialFactories() {
+  static const std::map<std::string, MaterialFactory> factories = {
+      {"ElasticIsotropic",
+       materialFactory<muesli::elasticIsotropicMaterial, muesli::elasticIsotropicMP, SmallStrainMPBatch>()},
+      {"ElasticAnisotropic",
+       materialFactory<muesli::elasticAnisotropicMaterial, muesli::elasticAnisotropicMP, SmallStrainMPBatch>()},
+      {"ElasticOrthotropic",
+       materialFactory<muesli::elasticOrthotropicMaterial, muesli::elasticOrthotropicMP, SmallStrainMPBatch>()},
+      {"ElasticTransverselyisotropic",
+       materialFactory<muesli::elasticTransverselyisotropicMaterial, muesli::elasticTransverselyisotropicMP,
+                       SmallStrainMPBatch>()},
+      {"Splastic", materialFactory<muesli::splasticMaterial, muesli::splasticMP, SmallStrainMPBatch>()},
+      {"Viscoelastic", materialFactory<muesli::viscoelasticMaterial, muesli::viscoelasticMP, SmallStrainMPBatch>()},
+      {"Viscoplastic", materialFactory<muesli::viscoplasticMaterial, muesli::viscoplasticMP, SmallStrainMPBatch>()},
+      {"GTN", materialFactory<muesli::GTN_Material, muesli::GTN_MP, SmallStrainMPBatch>()},
+      {"Gurson", materialFactory<muesli::Gurson_Material, muesli::Gurson_MP, SmallStrainMPBatch>()},
+      {"Lemaitre", materialFactory<muesli::Lemaitre_Material, muesli::Lemaitre_MP, SmallStrainMPBatch>()},
+      {"LemKin", materialFactory<muesli::LemKin_Material, muesli::LemKin_MP, SmallStrainMPBatch>()},
+      {"NeoHooke", materialFactory<muesli::neohookeanMaterial, muesli::neohookeanMP, FiniteStrainMPBatch>()},
+      {"SVK", materialFactory<muesli::svkMaterial, muesli::svkMP, FiniteStrainMPBatch>()},
+      {"Mooney", materialFactory<muesli::mooneyMaterial, muesli::mooneyMP, FiniteStrainMPBatch>()},
+      {"ArrudaBoyce", materialFactory<muesli::arrudaboyceMaterial, muesli::arrudaboyceMP, FiniteStrainMPBatch>()},
+      {"Yeoh", materialFactory<muesli::yeohMaterial, muesli::yeohMP, FiniteStrainMPBatch>()},
+      {"Fplastic", materialFactory<muesli::fplasticMaterial, muesli::fplasticMP, FiniteStrainMPBatch>()},
+  };
+  return factories;
+}
+
+static_assert(static_cast<int>(JLMUESLI_POINT_FAILED) == static_cast<int>(PS_FAILED) && pointStatusCount == 6,
+              "C status codes follow PointStatus.");
+
+} // namespace
+
+extern "C" {
+
+int jlmuesli_api_version(void) { return JLMUESLI_C_API_VERSION; }
+
+const char* jlmuesli_last_error(void) { return lastError.c_str(); }
+
+int jlmuesli_material_create(const char* model, const char* const* keys, const double* values, size_t count,
+                             jlmuesli_material** material) {
+  return guarded([&] {
+    if (model == nullptr || material == nullptr || (count > 0 && (keys == nullptr || values == nullptr)))
+      throw std::invalid_argument("Arguments must not be null.");
+    const auto factory = materialFactories().find(model);
+    if (factory == materialFactories().end())
+      throw std::invalid_argument("Unknown material model " + std::string(model) + ".");
+    std::multimap<std::string, double> properties;
+    for (size_t i = 0; i < count; ++i) {
+      if (keys[i] == nullptr)
+        throw std::invalid_argument("Property keys must not be null.");
+      properties.insert({keys[i], values[i]});
+    }
+    *material = factory->second(model, properties);
+  });
+}
+
+void jlmuesli_material_destroy(jlmuesli_material* material) { delete material; }
+
+int jlmuesli_material_finite_strain(const jlmuesli_material* material) {
+  return material != nullptr && material->finiteStrain();
+}
+
+int jlmuesli_batch_create(const jlmuesli_material* material, size_t n, jlmuesli_batch** batch) {
+  return guarded([&] {
+    if (batch == nullptr)
+      throw std::invalid_argument("Arguments must not be null.");
+    *batch = checkedHandle(material).createBatch(n).release();
+  });
+}
+
+void jlmuesli_batch_destroy(jlmuesli_batch* batch) { delete batch; }
+
+size_t jlmuesli_batch_size(const jlmuesli_batch* batch) { return batch != nullptr ? batch->size() : 0; }
+
+int jlmuesli_batch_finite_strain(const jlmuesli_batch* batch) { return batch != nullptr && batch->finiteStrain(); }
+
+int jlmuesli_batch_update(jlmuesli_batch* batch, double time, const double* input, size_t components, size_t length) {
+  return guarded([&] {
+    auto& handle = checkedHandle(batch);
+    components   = inputComponents(handle, components);
+    checkBuffer(input, length, components, handle.size());
+    handle.update(time, input, components);
+  });
+}
+
+int jlmuesli_batch_stress(const jlmuesli_batch* batch, double* stress, size_t components, size_t length) {
+  return guarded([&] {
+    const auto& handle = checkedHandle(batch);
+    components         = symmetricComponents(components);
+    checkBuffer(stress, length, components, handle.size());
+    handle.stress(stress, components);
+  });
+}
+
+int jlmuesli_batch_tangent(const jlmuesli_batch* batch, double* tangent, int layout, size_t length) {
+  return guarded([&] {
+    const auto& handle       = checkedHandle(batch);
+    const TangentLayout kind = tangentLayout(layout);
+    checkBuffer(tangent, length, tangentComponents(kind), handle.size());
+    handle.tangent(tangent, kind);
+  });
+}
+
+int jlmuesli_batch_energy(const jlmuesli_batch* batch, double* energy, size_t length) {
+  return guarded([&] {
+    const auto& handle = checkedHandle(batch);
+    checkBuffer(energy, length, 1, handle.size());
+    handle.energy(energy);
+  });
+}
+
+int jlmuesli_batch_evaluate(jlmuesli_batch* batch, double time, const double* input, double* stress,
+                            size_t components, double* tangent, int layout, double* energy, size_t points) {
+  return guarded([&] {
+    auto& handle             = checkedHandle(batch);
+    const TangentLayout kind = tangentLayout(layout);
+    components               = inputComponents(handle, components);
+    if (points != handle.size())
+      throw std::invalid_argument("Number of points does not match the batch.");
+    if (input == nullptr || stress == nullptr || tangent == nullptr || energy == nullptr)
+      throw std::invalid_argument("Buffer must not be null.");
+    handle.evaluate(time, input, stress, components, tangent, kind, energy);
+  });
+}
+
+int jlmuesli_batch_commit(jlmuesli_batch* batch) {
+  return guarded([&] { checkedHandle(batch).commit(); });
+}
+
+int jlmuesli_batch_reset(jlmuesli_batch* batch) {
+  return guarded([&] { checkedHandle(batch).reset(); });
+}
+
+int jlmuesli_batch_set_status_tracking(jlmuesli_batch* batch, int enabled) {
+  return guarded([&] { checkedHandle(batch).setStatusTracking(enabled != 0); });
+}
+
+int jlmuesli_batch_status(const jlmuesli_batch* batch, unsigned char* status, size_t length, size_t* failures) {
+  return guarded([&] {
+    const auto& handle = checkedHandle(batch);
+    if (!handle.statusTracking())
+      throw std::logic_error("Status tracking is not enabled for this batch.");
+    if (status != nullptr) {
+      checkBuffer(status, length, 1, handle.size());
+      std::copy(handle.status(), handle.status() + handle.size(), status);
+    }
+    if (failures != nullptr)
+      *failures = summarizeStatus(handle.status(), handle.size()).failures();
+  });
+}
+
+int jlmuesli_batch_set_substepping(jlmuesli_batch* batch, size_t max_levels, double increment_limit) {
+  return guarded([&] { checkedHandle(batch).setSubstepping(max_levels, increment_limit); });
+}
+
+int jlmuesli_batch_substeps(const jlmuesli_batch* batch, unsigned int* substeps, size_t length) {
+  return guarded([&] {
+    const auto& handle = checkedHandle(batch);
+    if (!handle.substepping())
+      throw std::logic_error("Substepping is not enabled for this batch.");
+    checkBuffer(substeps, length, 1, handle.size());
+    std::copy(handle.substeps(), handle.substeps() + handle.size(), substeps);
+  });
+}
+
+} // extern "C"
@@ -0,0 +1,118 @@
+/* SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#ifndef JLMUESLI_H
+#define JLMUESLI_H
+
+#include <stddef.h>
+
+/* Plain C interface of libjlmuesli for the hot batch operations, callable through ccall from Julia or from C and
+ * Fortran. Materials and batches are opaque handles, arrays are raw pointers with their length in doubles. Arrays use
+ * the layouts of the jlcxx module: symmetric tensors as 6 Voigt (engineering shear for strains) or 9 column-major
+ * components per point, deformation gradients as 9 column-major components, tangents as 81 (full), 36 (Voigt) or 21
+ * (packed) components per point.
+ *
+ * Every function returning int returns JLMUESLI_OK on success and an error code otherwise, the message of the last
+ * error on the calling thread is available from jlmuesli_last_error. No function throws. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define JLMUESLI_C_API_VERSION 1
+
+enum jlmuesli_status
+{
+  JLMUESLI_OK               = 0,
+  JLMUESLI_INVALID_ARGUMENT = 1,
+  JLMUESLI_UNSUPPORTED      = 2,
+  JLMUESLI_ERROR            = 3
+};
+
+enum jlmuesli_tangent_layout
+{
+  JLMUESLI_TANGENT_FULL   = 0,
+  JLMUESLI_TANGENT_VOIGT  = 1,
+  JLMUESLI_TANGENT_PACKED = 2
+};
+
+typedef struct jlmuesli_material jlmuesli_material;
+typedef struct jlmuesli_batch jlmuesli_batch;
+
+int jlmuesli_api_version(void);
+
+/* Message of the last failed call on this thread, empty if there was none */
+const char* jlmuesli_last_error(void);
+
+/* Creates a material of the named model from count (key, value) properties as taken by MaterialProperties. String
+ * options are passed as key "name option" with any value. Models are ElasticIsotropic, ElasticAnisotropic,
+ * ElasticOrthotropic, ElasticTransverselyisotropic, Splastic, Viscoelastic, Viscoplastic, GTN, Gurson, Lemaitre and
+ * LemKin in small strain and NeoHooke, SVK, Mooney, ArrudaBoyce, Yeoh and Fplastic in finite strain. */
+int jlmuesli_material_create(const char* model, const char* const* keys, const double* values, size_t count,
+                             jlmuesli_material** material);
+void jlmuesli_material_destroy(jlmuesli_material* material);
+
+/* 1 for finite-strain models, whose batches take deformation gradients, 0 for small-strain models */
+int jlmuesli_material_finite_strain(const jlmuesli_material* material);
+
+/* Batch of n points of a material, the material has to outlive the batch */
+int jlmuesli_batch_create(const jlmuesli_material* material, size_t n, jlmuesli_batch** batch);
+
+/* Destroys a handle. Handles borrowed from the Julia module (capiHandle) leave the batch itself alive. */
+void jlmuesli_batch_destroy(jlmuesli_batch* batch);
+
+size_t jlmuesli_batch_size(const jlmuesli_batch* batch);
+int jlmuesli_batch_finite_strain(const jlmuesli_batch* batch);
+
+/* Strains (components 6 or 9) or deformation gradients (components 9) of all points */
+int jlmuesli_batch_update(jlmuesli_batch* batch, double time, const double* input, size_t components, size_t length);
+
+/* Stress, or second Piola-Kirchhoff stress for finite strain, components 6 or 9 */
+int jlmuesli_batch_stress(const jlmuesli_batch* batch, double* stress, size_t components, size_t length);
+
+/* Tangent, or convected tangent for finite strain. The packed layout is rejected with JLMUESLI_UNSUPPORTED for
+ * models whose tangents may lack major symmetry (GTN, Gurson, Lemaitre, LemKin and Fplastic). */
+int jlmuesli_batch_tangent(const jlmuesli_batch* batch, double* tangent, int layout, size_t length);
+
+int jlmuesli_batch_energy(const jlmuesli_batch* batch, double* energy, size_t length);
+
+/* Update and stress, tangent and energy in one sweep, stress and strain share the number of components */
+int jlmuesli_batch_evaluate(jlmuesli_batch* batch, double time, const double* input, double* stress,
+                            size_t components, double* tangent, int layout, double* energy, size_t points);
+
+int jlmuesli_batch_commit(jlmuesli_batch* batch);
+int jlmuesli_batch_reset(jlmuesli_batch* batch);
+
+/* Per-point status codes of the last update or evaluate, see pointstatus.hh. With tracking enabled a failing point
+ * does not fail the call, its code is recorded and it is reset to its converged state. Its outputs of
+ * jlmuesli_batch_evaluate hold the response of that converged state. */
+enum jlmuesli_point_status
+{
+  JLMUESLI_POINT_CONVERGED           = 0,
+  JLMUESLI_POINT_ITERATIONS_EXCEEDED = 1,
+  JLMUESLI_POINT_NEGATIVE_JACOBIAN   = 2,
+  JLMUESLI_POINT_FULLY_DAMAGED       = 3,
+  JLMUESLI_POINT_NON_FINITE          = 4,
+  JLMUESLI_POINT_FAILED              = 5
+};
+
+int jlmuesli_batch_set_status_tracking(jlmuesli_batch* batch, int enabled);
+
+/* Copies the status of all points to status (may be null) and stores the number of failed points, i.e. neither
+ * converged nor fully damaged, in failures (may be null) */
+int jlmuesli_batch_status(const jlmuesli_batch* batch, unsigned char* status, size_t length, size_t* failures);
+
+/* Local substepping of failing points for the plasticity and damage models, with up to 2^max_levels substeps per
+ * point, max_levels 0 disables it. With increment_limit > 0 the plasticity models also split increments larger than
+ * increment_limit yield strains up front. */
+int jlmuesli_batch_set_substepping(jlmuesli_batch* batch, size_t max_levels, double increment_limit);
+
+/* Copies the substeps of the last update of all points to substeps, 1 for a plain update and 0 for a point that
+ * could not be recovered */
+int jlmuesli_batch_substeps(const jlmuesli_batch* batch, unsigned int* substeps, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
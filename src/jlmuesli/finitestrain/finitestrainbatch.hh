@@ -0,0 +1,230 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <jlmuesli/util/layout.hh>
+#include <jlmuesli/util/mpbatch.hh>
+
+#include <cstddef>
+
+#include <muesli/muesli.h>
+
+// Batch of finite-strain material points. Deformation gradients and first Piola-Kirchhoff stresses are passed as 9
+// column-major components per point, symmetric stresses either as 6 Voigt or 9 column-major components (see
+// layout.hh). The minor symmetric convected and spatial tangents can be written in any TangentLayout, the material
+// tangent dP/dF only as full tensor. All conversions work in place, there is no allocation per point. With caching
+// enabled, the second Piola-Kirchhoff stress, the convected tangent and the energy are memoized.
+template <typename Material, typename MaterialPoint>
+class FiniteStrainMPBatch : public MPBatch<Material, MaterialPoint>
+{
+  using Base = MPBatch<Material, MaterialPoint>;
+  using Base::bucketing_;
+  using Base::cache_;
+  using Base::forEachRange;
+  using Base::kernelEnabled_;
+  using Base::plasticity_;
+  using Base::points_;
+  using Base::predictor_;
+
+public:
+  using Base::Base;
+  using Base::size;
+
+  // See MPBatch::configureSubstepping, substeps interpolate the deformation gradient linearly
+  void setSubstepping(std::size_t maxLevels, double incrementLimit = 0.0) {
+    const double identity[9] = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+    this->configureSubstepping(maxLevels, incrementLimit, identity);
+  }
+
+  void updateCurrentState(double t, const double* F) {
+    cache_.invalidate();
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+        updatePoint(i, t, F);
+    });
+  }
+
+  void firstPiolaKirchhoffStress(double* P) const {
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      itensor T;
+      for (std::size_t i = begin; i < end; ++i) {
+        points_[i].firstPiolaKirchhoffStress(T);
+        writeColumnMajor(T, P + 9 * i);
+      }
+    });
+  }
+
+  void secondPiolaKirchhoffStress(double* S, std::size_t components) const {
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      istensor scratch;
+      ResponseCache::Counter counter(cache_);
+      for (std::size_t i = begin; i < end; ++i) {
+        const istensor& T =
+            cache_.stress(i, scratch, counter, [&](istensor& out) { points_[i].secondPiolaKirchhoffStress(out); });
+        writeStressComponents(T, S + i * components, components);
+      }
+    });
+  }
+
+  void CauchyStress(double* sigma, std::size_t components) const {
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      istensor T;
+      for (std::size_t i = begin; i < end; ++i) {
+        points_[i].CauchyStress(T);
+        writeStressComponents(T, sigma + i * components, components);
+      }
+    });
+  }
+
+  void convectedTangent(double* C, TangentLayout layout = TangentLayout::Full) const {
+    checkTangentLayout<MaterialPoint>(layout);
+    const std::size_t stride = tangentComponents(layout);
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      itensor4 scratch;
+      ResponseCache::Counter counter(cache_);
+      for (std::size_t i = begin; i < end; ++i) {
+        const itensor4& T =
+            cache_.tangent(i, scratch, counter, [&](itensor4& out) { points_[i].convectedTangent(out); });
+        writeTangent(T, C + stride * i, layout);
+      }
+    });
+  }
+
+  void materialTangent(double* C) const {
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      itensor4 T;
+      for (std::size_t i = begin; i < end; ++i) {
+        points_[i].materialTangent(T);
+        writeColumnMajor(T, C + 81 * i);
+      }
+    });
+  }
+
+  void spatialTangent(double* C, TangentLayout layout = TangentLayout::Full) const {
+    checkTangentLayout<MaterialPoint>(layout);
+    const std::size_t stride = tangentComponents(layout);
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      itensor4 T;
+      for (std::size_t i = begin; i < end; ++i) {
+        points_[i].spatialTangent(T);
+        writeTangent(T, C + stride * i, layout);
+      }
+    });
+  }
+
+  // Total Lagrangian element stiffness, B^T C B from the convected tangent plus the geometric term from S, for
+  // elements made of consecutive points (see MPBatch::assembleElementStiffness). dN are reference gradients.
+  void elementStiffness(const double* dN, const double* weights, std::size_t nodes, std::size_t elements,
+                        double* K) const {
+    const auto tangent = [&](std::size_t i, ResponseCache::Counter& counter, double* A) {
+      const auto& mp = points_[i];
+      istensor stressScratch;
+      itensor4 tangentScratch;
+      const istensor& S = cache_.stress(i, stressScratch, counter,
+                                        [&](istensor& out) { mp.secondPiolaKirchhoffStress(out); });
+      const itensor4& C = cache_.tangent(i, tangentScratch, counter, [&](itensor4& out) { mp.convectedTangent(out); });
+      tangentToArray(mp.deformationGradient(), S, C, A);
+    };
+    this->assembleElementStiffness(dN, weights, nodes, elements, K, tangent);
+  }
+
+  // Updates all points and evaluates the second Piola-Kirchhoff stress, the convected tangent and the energy in a
+  // single sweep. With the vectorized kernel the response is not cached.
+  void evaluate(double t, const double* F, double* S, std::size_t components, double* C, TangentLayout layout,
+                double* energy) {
+    checkTangentLayout<MaterialPoint>(layout);
+    cache_.invalidate();
+    if constexpr (PlasticPredictor<MaterialPoint>::available) {
+      if (bucketing_) {
+        this->bucketedSweep(
+            [&](std::size_t begin, std::size_t end, unsigned char* plastic) {
+              predictor_.classify(plasticity_, begin, end, F, plastic);
+            },
+            [&](std::size_t i) { updatePoint(i, t, F); },
+            // The convected tangent of fplastic depends on the deformation in elastic steps too, so there is no
+            // shared elastic tangent and bucketing only reorders the points
+            [&](std::size_t i, bool /*stayedElastic*/) {
+              istensor stress;
+              itensor4 T;
+              writeResponse(i, S, components, C, layout, energy, stress, T);
+              if (this->checkResponse(i, S + i * components, components))
+                writeResponse(i, S, components, C, layout, energy, stress, T);
+            });
+        return;
+      }
+    }
+    if constexpr (BatchKernel<MaterialPoint>::available) {
+      if (kernelEnabled_) {
+        forEachRange([&](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i)
+            updatePoint(i, t, F);
+          this->evaluateKernel(begin, end, F, 9, S, components, C, layout, energy);
+          // The kernel evaluates the input, failed points report the response of their converged state instead
+          istensor stress;
+          itensor4 T;
+          for (std::size_t i = begin; i < end; ++i)
+            if (this->checkResponse(i, S + i * components, components))
+              writeResponse(i, S, components, C, layout, energy, stress, T);
+        });
+        return;
+      }
+    }
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      istensor stress;
+      itensor4 T;
+      for (std::size_t i = begin; i < end; ++i) {
+        updatePoint(i, t, F);
+        writeResponse(i, S, components, C, layout, energy, stress, T);
+        if (this->checkResponse(i, S + i * components, components))
+          writeResponse(i, S, components, C, layout, energy, stress, T);
+      }
+    });
+  }
+
+private:
+  // Writes the second Piola-Kirchhoff stress, the convected tangent and the energy of point i to the outputs of all
+  // points and caches them, stress and T are scratch
+  void writeResponse(std::size_t i, double* S, std::size_t components, double* C, TangentLayout layout,
+                     double* energy, istensor& stress, itensor4& T) {
+    auto& mp = stressedPoint(i, stress);
+    writeStressComponents(stress, S + i * components, components);
+    mp.convectedTangent(T);
+    writeTangent(T, C + tangentComponents(layout) * i, layout);
+    energy[i] = mp.storedEnergy();
+    cache_.store(i, stress, T, energy[i]);
+  }
+
+  // Updates point i to its deformation gradient, see MPBatch::updatePoint and MPBatch::substepPoint
+  void updatePoint(std::size_t i, double t, const double* F) {
+    const double* Fi = F + 9 * i;
+    if (this->substepping()) {
+      this->substepPoint(i, t, Fi, deformationStatus(Fi), &updateTo, &stressFailed);
+      return;
+    }
+    Base::updatePoint(
+        i, [&] { return deformationStatus(Fi); },
+        [&](MaterialPoint& mp) { mp.updateCurrentState(t, itensorFromColumnMajor(Fi)); });
+  }
+
+  // Writes the second Piola-Kirchhoff stress of point i to S and returns the point. With substepping, a point whose
+  // stress is not finite is updated again in substeps first, see MPBatch::recoverResponse.
+  MaterialPoint& stressedPoint(std::size_t i, istensor& S) {
+    points_[i].secondPiolaKirchhoffStress(S);
+    if (this->substepping() && this->recoverResponse(i, S, &updateTo, &stressFailed))
+      points_[i].secondPiolaKirchhoffStress(S);
+    return points_[i];
+  }
+
+  static void updateTo(MaterialPoint& mp, double t, const double* F) {
+    mp.updateCurrentState(t, itensorFromColumnMajor(F));
+  }
+
+  static bool stressFailed(const MaterialPoint& mp) {
+    istensor S;
+    mp.secondPiolaKirchhoffStress(S);
+    double values[9];
+    writeColumnMajor(S, values);
+    return !allFinite(values, 9);
+  }
+};
@@ -1,15 +1,313 @@
 // SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <jlmuesli/capi/batchhandle.hh>
+#include <jlmuesli/finitestrain/finitestrainbatch.hh>
+#include <jlmuesli/finitestrain/hyperelasticevaluator.hh>
 #include <jlmuesli/finitestrain/registerfinitestrain.hh>
 #include <jlmuesli/util/common.hh>
+#include <jlmuesli/util/evaluate.hh>
+#include <jlmuesli/util/instrumentation.hh>
+#include <jlmuesli/util/tangentsymmetry.hh>
 #include <jlmuesli/util/utils.hh>
 
+#include <type_traits>
+
 #include <muesli/muesli.h>
 #include <muesli/Utils/utils.h>
 
 #include <jlcxx/jlcxx.hpp>
 
+template <typename Batch, typename StressArray, void (Batch::*stress)(double*, size_t) const>
+void finiteStrainBatchStress(Batch& batch, StressArray S) {
+  constexpr size_t components = BatchLayout<StressArray>::symmetricComponents;
+  (batch.*stress)(assertBatchSizeAndExtractData(S, components, batch.size()), components);
+}
+
+template <typename Batch, typename TangentArray, void (Batch::*tangent)(double*, TangentLayout) const>
+void finiteStrainBatchTangent(Batch& batch, TangentArray C) {
+  constexpr TangentLayout layout = BatchLayout<TangentArray>::tangent;
+  (batch.*tangent)(assertBatchSizeAndExtractData(C, tangentComponents(layout), batch.size()), layout);
+}
+
+template <typename Batch, typename StressArray, typename TangentArray>
+void evaluateFiniteStrainBatch(Batch& batch, double theTime, JuliaTensorBatch F, StressArray S, TangentArray C,
+                               JuliaVector energy) {
+  constexpr size_t components    = BatchLayout<StressArray>::symmetricComponents;
+  constexpr TangentLayout layout = BatchLayout<TangentArray>::tangent;
+  const size_t n                 = batch.size();
+  batch.evaluate(theTime, assertBatchSizeAndExtractData(F, 9, n), assertBatchSizeAndExtractData(S, components, n),
+                 components, assertBatchSizeAndExtractData(C, tangentComponents(layout), n), layout,
+                 assertBatchSizeAndExtractData(energy, 1, n));
+}
+
+// Fused update and evaluation of a single point: stored energy, second Piola-Kirchhoff stress and convected tangent.
+// Only the outputs selected by flags (EvaluateFlags) are written, the energy is returned if requested and 0 otherwise.
+template <typename MaterialPoint, typename TangentArray>
+double evaluateFiniteStrainPoint(MaterialPoint& mp, double theTime, JuliaTensor F, JuliaTensor S, TangentArray C,
+                                 jlcxx::cxxint_t flags) {
+  if constexpr (std::is_same_v<TangentArray, JuliaVector>)
+    checkTangentLayout<MaterialPoint>(TangentLayout::Packed);
+  mp.updateCurrentState(theTime, toITensor(F));
+  if (flags & EVAL_STRESS) {
+    istensor T;
+    mp.secondPiolaKirchhoffStress(T);
+    writeToArray(T, S);
+  }
+  if (flags & EVAL_TANGENT) {
+    itensor4 T;
+    mp.convectedTangent(T);
+    writeToArray(T, C);
+  }
+  return (flags & EVAL_ENERGY) ? mp.storedEnergy() : 0.0;
+}
+
+// Deformation gradient driven history of a single point, see pointdriver.hh. F and S hold one slice per time. With a
+// status vector the status of every step is recorded instead of throwing. Returns the number of completed steps.
+template <typename Material, typename MaterialPoint, typename StressArray, typename... Status>
+jlcxx::cxxint_t driveFiniteStrainHistory(const Material& material, JuliaVector times, JuliaTensorBatch F,
+                                         StressArray S, JuliaVector energy, jlcxx::ArrayRef<StateField, 1> fields,
+                                         jlcxx::ArrayRef<jlcxx::cxxint_t, 1> indices, JuliaTensor state,
+                                         jlcxx::cxxint_t flags, Status... status) {
+  const size_t steps     = times.size();
+  PointHistoryOutput out = pointHistoryOutput(steps, S, energy, fields, indices, state, flags);
+  out.status             = statusData(steps, status...);
+  return driveFiniteStrainPoint<MaterialPoint>(material, steps, times.data(),
+                                               assertBatchSizeAndExtractData(F, 9, steps), out);
+}
+
+// Mixed controlled history of a single point on F and P, see pointdriver.hh. control holds 9 column-major flags,
+// prescribed, F and P one 3 x 3 slice per time. Returns the number of converged steps, with a status vector failures
+// are recorded per step instead of thrown.
+template <typename Material, typename MaterialPoint, typename... Status>
+jlcxx::cxxint_t driveFiniteStrainMixedHistory(const Material& material, JuliaVector times,
+                                              jlcxx::ArrayRef<jlcxx::cxxint_t, 1> control,
+                                              JuliaTensorBatch prescribed, JuliaTensorBatch F, JuliaTensorBatch P,
+                                              JuliaVector energy, jlcxx::ArrayRef<StateField, 1> fields,
+                                              jlcxx::ArrayRef<jlcxx::cxxint_t, 1> indices, JuliaTensor state,
+                                              jlcxx::ArrayRef<jlcxx::cxxint_t, 1> iterations, JuliaVector residual,
+                                              double tolerance, jlcxx::cxxint_t maxIterations, Status... status) {
+  if (maxIterations < 0)
+    throw std::invalid_argument("Number of iterations must not be negative.");
+  const size_t steps     = times.size();
+  const auto flags       = controlFlags(control, 9);
+  MixedHistoryOutput out = mixedHistoryOutput(steps, 9, F, P, energy, fields, indices, state, iterations, residual);
+  out.status             = statusData(steps, status...);
+  return driveFiniteStrainMixed<MaterialPoint>(material, steps, times.data(), flags.data(),
+                                               assertBatchSizeAndExtractData(prescribed, 9, steps),
+                                               NewtonOptions{tolerance, static_cast<size_t>(maxIterations)}, out);
+}
+
+// Number of points of a 3 x 3 x N array of deformation gradients
+inline size_t deformationGradientCount(JuliaTensorBatch F) {
+  if (F.size() % 9 != 0)
+    throw std::invalid_argument("Deformation gradients have to be a 3 x 3 x N array.");
+  return F.size() / 9;
+}
+
+template <typename Evaluator, typename StressArray, typename TangentArray>
+void evaluateHyperelastic(const Evaluator& evaluator, JuliaTensorBatch F, StressArray S, TangentArray C,
+                          JuliaVector energy) {
+  constexpr size_t components    = BatchLayout<StressArray>::symmetricComponents;
+  constexpr TangentLayout layout = BatchLayout<TangentArray>::tangent;
+  const size_t n                 = deformationGradientCount(F);
+  evaluator.evaluate(n, F.data(), assertBatchSizeAndExtractData(S, components, n), components,
+                     assertBatchSizeAndExtractData(C, tangentComponents(layout), n), layout,
+                     assertBatchSizeAndExtractData(energy, 1, n));
+}
+
+template <typename Evaluator>
+void evaluateHyperelasticFirstPiola(const Evaluator& evaluator, JuliaTensorBatch F, JuliaTensorBatch P,
+                                    JuliaTensor4Batch A, JuliaVector energy) {
+  const size_t n = deformationGradientCount(F);
+  evaluator.evaluateFirstPiola(n, F.data(), assertBatchSizeAndExtractData(P, 9, n),
+                               assertBatchSizeAndExtractData(A, 81, n), assertBatchSizeAndExtractData(energy, 1, n));
+}
+
+template <typename Evaluator>
+void hyperelasticEnergy(const Evaluator& evaluator, JuliaTensorBatch F, JuliaVector energy) {
+  const size_t n = deformationGradientCount(F);
+  evaluator.storedEnergy(n, F.data(), assertBatchSizeAndExtractData(energy, 1, n));
+}
+
+// Stateless evaluation of a hyperelastic model, see hyperelasticevaluator.hh
+template <typename Material, typename MaterialPoint>
+void registerHyperelasticEvaluator(jlcxx::Module& mod, const std::string& name) {
+  using Evaluator = HyperelasticEvaluator<Material, MaterialPoint>;
+  using IM        = InstrumentedMethod;
+
+  registerInstrumentedType<Evaluator>(name);
+
+  mod.add_type<Evaluator>(name)
+      .constructor([](const Material& material) { return new Evaluator(material); })
+      .method("simdKernel", [](const Evaluator& evaluator) { return evaluator.simdKernel(); })
+
+      // --- Fused evaluation of energy, S and convected tangent ---
+      .method("evaluate!",
+              instrumented<Evaluator, IM::Evaluate>(&evaluateHyperelastic<Evaluator, JuliaTensor, JuliaTensor>))
+      .method("evaluate!",
+              instrumented<Evaluator, IM::Evaluate>(&evaluateHyperelastic<Evaluator, JuliaTensor, JuliaTensorBatch>))
+      .method("evaluate!",
+              instrumented<Evaluator, IM::Evaluate>(&evaluateHyperelastic<Evaluator, JuliaTensor, JuliaTensor4Batch>))
+      .method("evaluate!",
+              instrumented<Evaluator, IM::Evaluate>(&evaluateHyperelastic<Evaluator, JuliaTensorBatch, JuliaTensor>))
+      .method("evaluate!",
+              instrumented<Evaluator, IM::Evaluate>(
+                  &evaluateHyperelastic<Evaluator, JuliaTensorBatch, JuliaTensorBatch>))
+      .method("evaluate!",
+              instrumented<Evaluator, IM::Evaluate>(
+                  &evaluateHyperelastic<Evaluator, JuliaTensorBatch, JuliaTensor4Batch>))
+
+      // --- Energy, P and dP/dF ---
+      .method("evaluateFirstPiola!",
+              instrumented<Evaluator, IM::Evaluate>(&evaluateHyperelasticFirstPiola<Evaluator>))
+      .method("storedEnergy!", instrumented<Evaluator, IM::Energy>(&hyperelasticEnergy<Evaluator>));
+}
+
+template <typename Material, typename MaterialPoint>
+void registerFiniteStrainMPBatch(jlcxx::Module& mod, const std::string& name) {
+  using Batch = FiniteStrainMPBatch<Material, MaterialPoint>;
+  using IM    = InstrumentedMethod;
+
+  registerInstrumentedType<Batch>(name);
+
+  mod.add_type<Batch>(name)
+      .constructor([](const Material& mat, jlcxx::cxxint_t n) {
+        if (n < 0)
+          throw std::invalid_argument("Number of material points must not be negative.");
+        return new Batch(mat, n);
+      })
+      .method("size", [](const Batch& batch) { return batch.size(); })
+
+      // 1-based access to the points, the returned references carry no finalizer and take all per-point methods
+      .method("materialPoint",
+              [](Batch& batch, jlcxx::cxxint_t i) -> MaterialPoint& {
+                if (i < 1 || static_cast<size_t>(i) > batch.size())
+                  throw std::out_of_range("Index out of range in materialPoint.");
+                return batch[i - 1];
+              })
+
+      // Deformation gradients are given as 3 x 3 x N array
+      .method("updateCurrentState",
+              instrumented<Batch, IM::UpdateCurrentState>([](Batch& batch, double theTime, JuliaTensorBatch F) {
+                batch.updateCurrentState(theTime, assertBatchSizeAndExtractData(F, 9, batch.size()));
+              }))
+
+      // --- Stresses, symmetric ones either as 6 x N Voigt matrix or as 3 x 3 x N array ---
+      .method("firstPiolaKirchhoffStress!",
+              instrumented<Batch, IM::Stress>([](Batch& batch, JuliaTensorBatch P) {
+                batch.firstPiolaKirchhoffStress(assertBatchSizeAndExtractData(P, 9, batch.size()));
+              }))
+      .method("secondPiolaKirchhoffStress!",
+              instrumented<Batch, IM::Stress>(
+                  &finiteStrainBatchStress<Batch, JuliaTensor, &Batch::secondPiolaKirchhoffStress>))
+      .method("secondPiolaKirchhoffStress!",
+              instrumented<Batch, IM::Stress>(
+                  &finiteStrainBatchStress<Batch, JuliaTensorBatch, &Batch::secondPiolaKirchhoffStress>))
+      .method("CauchyStress!",
+              instrumented<Batch, IM::Stress>(&finiteStrainBatchStress<Batch, JuliaTensor, &Batch::CauchyStress>))
+      .method("CauchyStress!",
+              instrumented<Batch, IM::Stress>(&finiteStrainBatchStress<Batch, JuliaTensorBatch, &Batch::CauchyStress>))
+
+      // --- Elasticity tangents, as 21 x N packed, 6 x 6 x N Voigt or 3 x 3 x 3 x 3 x N array ---
+      .method("convectedTangent!",
+              instrumented<Batch, IM::Tangent>(&finiteStrainBatchTangent<Batch, JuliaTensor, &Batch::convectedTangent>))
+      .method("convectedTangent!",
+              instrumented<Batch, IM::Tangent>(
+                  &finiteStrainBatchTangent<Batch, JuliaTensorBatch, &Batch::convectedTangent>))
+      .method("convectedTangent!",
+              instrumented<Batch, IM::Tangent>(
+                  &finiteStrainBatchTangent<Batch, JuliaTensor4Batch, &Batch::convectedTangent>))
+      .method("spatialTangent!",
+              instrumented<Batch, IM::Tangent>(&finiteStrainBatchTangent<Batch, JuliaTensor, &Batch::spatialTangent>))
+      .method("spatialTangent!",
+              instrumented<Batch, IM::Tangent>(
+                  &finiteStrainBatchTangent<Batch, JuliaTensorBatch, &Batch::spatialTangent>))
+      .method("spatialTangent!",
+              instrumented<Batch, IM::Tangent>(
+                  &finiteStrainBatchTangent<Batch, JuliaTensor4Batch, &Batch::spatialTangent>))
+      .method("materialTangent!",
+              instrumented<Batch, IM::Tangent>([](Batch& batch, JuliaTensor4Batch C) {
+                batch.materialTangent(assertBatchSizeAndExtractData(C, 81, batch.size()));
+              }))
+
+      // --- Energies ---
+      .method("storedEnergy!",
+              instrumented<Batch, IM::Energy>([](Batch& batch, JuliaVector energy) {
+                batch.storedEnergy(assertBatchSizeAndExtractData(energy, 1, batch.size()));
+              }))
+
+      // --- Fused update and evaluation (S, convected tangent and energy) ---
+      .method("evaluate!",
+              instrumented<Batch, IM::Evaluate>(&evaluateFiniteStrainBatch<Batch, JuliaTensor, JuliaTensor>))
+      .method("evaluate!",
+              instrumented<Batch, IM::Evaluate>(&evaluateFiniteStrainBatch<Batch, JuliaTensor, JuliaTensorBatch>))
+      .method("evaluate!",
+              instrumented<Batch, IM::Evaluate>(&evaluateFiniteStrainBatch<Batch, JuliaTensor, JuliaTensor4Batch>))
+      .method("evaluate!",
+              instrumented<Batch, IM::Evaluate>(&evaluateFiniteStrainBatch<Batch, JuliaTensorBatch, JuliaTensor>))
+      .method("evaluate!",
+              instrumented<Batch, IM::Evaluate>(&evaluateFiniteStrainBatch<Batch, JuliaTensorBatch, JuliaTensorBatch>))
+      .method("evaluate!",
+              instrumented<Batch, IM::Evaluate>(&evaluateFiniteStrainBatch<Batch, JuliaTensorBatch, JuliaTensor4Batch>))
+
+      // --- Bookkeeping ---
+      .method("commitCurrentState",
+              instrumented<Batch, IM::CommitCurrentState>([](Batch& batch) { batch.commitCurrentState(); }))
+      .method("resetCurrentState",
+              instrumented<Batch, IM::ResetCurrentState>([](Batch& batch) { batch.resetCurrentState(); }))
+      .method("elementStiffness!", instrumented<Batch, IM::Tangent>(&batchElementStiffness<Batch>))
+      .method("exportConvergedState!", &exportBatchState<Batch, JuliaTensor, true>)
+      .method("exportConvergedState!", &exportBatchState<Batch, JuliaVector, true>)
+      .method("exportCurrentState!", &exportBatchState<Batch, JuliaTensor, false>)
+      .method("exportCurrentState!", &exportBatchState<Batch, JuliaVector, false>)
+      .method("importConvergedState!", &importBatchState<Batch, JuliaTensor>)
+      .method("importConvergedState!", &importBatchState<Batch, JuliaVector>)
+      .method("saveConvergedState",
+              [name](const Batch& batch, const std::string& path) { batch.saveConvergedState(path, name); })
+      .method("restoreConvergedState!",
+              [name](Batch& batch, const std::string& path) { batch.restoreConvergedState(path, name); })
+
+      // Optional memoization of stress, tangent and energy between updates
+      .method("setCaching!", [](Batch& batch, bool enabled) { batch.setCaching(enabled); })
+      .method("caching", [](const Batch& batch) { return batch.caching(); })
+      .method("invalidateCache!", [](Batch& batch) { batch.invalidateCache(); })
+      .method("cacheHits", [](const Batch& batch) { return batch.cacheHits(); })
+      .method("cacheMisses", [](const Batch& batch) { return batch.cacheMisses(); })
+      .method("resetCacheCounters!", [](Batch& batch) { batch.resetCacheCounters(); })
+
+      // Vectorized evaluate! kernel, see simdkernels.hh
+      .method("simdKernel", [](const Batch& batch) { return batch.simdKernel(); })
+      .method("setSimdKernel!", [](Batch& batch, bool enabled) { batch.setSimdKernel(enabled); })
+
+      // Elastic/plastic bucketing of evaluate! for the plasticity models, the statistics hold points,
+      // predictedPlastic, plastic and mispredicted for each of the last 1024 sweeps
+      .method("setBucketing!", [](Batch& batch, bool enabled) { batch.setBucketing(enabled); })
+      .method("bucketing", [](const Batch& batch) { return batch.bucketing(); })
+      .method("bucketStatistics", &bucketStatistics<Batch>)
+      .method("resetBucketStatistics!", [](Batch& batch) { batch.resetBucketStatistics(); })
+
+      // Per-point status codes of the last update, see pointstatus.hh
+      .method("setStatusTracking!", [](Batch& batch, bool enabled) { batch.setStatusTracking(enabled); })
+      .method("statusTracking", [](const Batch& batch) { return batch.statusTracking(); })
+      .method("pointStatus!", &pointStatus<Batch>)
+      .method("statusSummary", &statusSummary<Batch>)
+
+      // Local substepping of failing points for the plasticity and damage models, see MPBatch::configureSubstepping.
+      // maxLevels 0 disables it, the statistics hold points, substeps, maxSubsteps and unrecovered of the last sweep.
+      .method("setSubstepping!",
+              [](Batch& batch, jlcxx::cxxint_t maxLevels, double incrementLimit) {
+                batch.setSubstepping(substepLevels(maxLevels), incrementLimit);
+              })
+      .method("substepping", [](const Batch& batch) { return batch.substepping(); })
+      .method("substeps!", &substeps<Batch>)
+      .method("substepStatistics", &substepStatistics<Batch>)
+
+      // Handle for the C API (jlmuesli.h) on this batch, to be released with jlmuesli_batch_destroy while the batch
+      // is alive
+      .method("capiHandle", [](Batch& batch) -> void* { return borrowedBatchHandle(batch); });
+}
+
 template <typename Material, typename MaterialPoint, typename MaterialBase, typename MaterialPointBase,
           bool registerConvergedState>
 std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> registerFiniteStrainMaterial(
@@ -17,6 +315,9 @@ std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> regis
   std::string matName = name + "Material";
   std::string mpName  = name + "MP";
 
+  using IM = InstrumentedMethod;
+  registerInstrumentedType<MaterialPoint>(mpName);
+
   using jlcxx::arg;
 
   auto mat = mod.add_type<Material>(matName, jlcxx::julia_base_type<MaterialBase>());
@@ -53,24 +354,110 @@ std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> regis
           .method("dissipatedEnergyDTheta", [](MaterialPoint& mp) { return mp.dissipatedEnergyDTheta(); })
           .method("kineticPotential", [](MaterialPoint& mp) { return mp.kineticPotential(); })
           .method("effectiveStoredEnergy", [](MaterialPoint& mp) { return mp.effectiveStoredEnergy(); })
-          .method("storedEnergy", [](MaterialPoint& mp) { return mp.storedEnergy(); })
+          .method("storedEnergy",
+                  instrumented<MaterialPoint, IM::Energy>([](MaterialPoint& mp) { return mp.storedEnergy(); }))
 
           // --- Stresses ---
-          .method("CauchyStress!", [](MaterialPoint& mp, istensor& sigma) { mp.CauchyStress(sigma); })
+          .method("CauchyStress!",
+                  instrumented<MaterialPoint, IM::Stress>(
+                      [](MaterialPoint& mp, istensor& sigma) { mp.CauchyStress(sigma); }))
           .method("energyMomentumTensor!", [](MaterialPoint& mp, itensor& S) { mp.energyMomentumTensor(S); })
-          .method("firstPiolaKirchhoffStress!", [](MaterialPoint& mp, itensor& P) { mp.firstPiolaKirchhoffStress(P); })
+          .method("firstPiolaKirchhoffStress!",
+                  instrumented<MaterialPoint, IM::Stress>(
+                      [](MaterialPoint& mp, itensor& P) { mp.firstPiolaKirchhoffStress(P); }))
           .method("firstPiolaKirchhoffStressNumerical!",
                   [](MaterialPoint& mp, itensor& P) { mp.firstPiolaKirchhoffStressNumerical(P); })
-          .method("KirchhoffStress!", [](MaterialPoint& mp, istensor& tau) { mp.KirchhoffStress(tau); })
+          .method("KirchhoffStress!",
+                  instrumented<MaterialPoint, IM::Stress>(
+                      [](MaterialPoint& mp, istensor& tau) { mp.KirchhoffStress(tau); }))
           .method("secondPiolaKirchhoffStress!",
-                  [](MaterialPoint& mp, istensor& S) { mp.secondPiolaKirchhoffStress(S); })
+                  instrumented<MaterialPoint, IM::Stress>(
+                      [](MaterialPoint& mp, istensor& S) { mp.secondPiolaKirchhoffStress(S); }))
           .method("secondPiolaKirchhoffStressNumerical!",
                   [](MaterialPoint& mp, istensor& S) { mp.secondPiolaKirchhoffStressNumerical(S); })
 
+          // --- Stresses, written directly into Julia arrays ---
+          .method("CauchyStress!",
+                  instrumented<MaterialPoint, IM::Stress>([](MaterialPoint& mp, JuliaTensor sigma) {
+                    istensor T;
+                    mp.CauchyStress(T);
+                    writeToArray(T, sigma);
+                  }))
+          .method("firstPiolaKirchhoffStress!",
+                  instrumented<MaterialPoint, IM::Stress>([](MaterialPoint& mp, JuliaTensor P) {
+                    itensor T;
+                    mp.firstPiolaKirchhoffStress(T);
+                    writeToArray(T, P);
+                  }))
+          .method("KirchhoffStress!",
+                  instrumented<MaterialPoint, IM::Stress>([](MaterialPoint& mp, JuliaTensor tau) {
+                    istensor T;
+                    mp.KirchhoffStress(T);
+                    writeToArray(T, tau);
+                  }))
+          .method("secondPiolaKirchhoffStress!",
+                  instrumented<MaterialPoint, IM::Stress>([](MaterialPoint& mp, JuliaTensor S) {
+                    istensor T;
+                    mp.secondPiolaKirchhoffStress(T);
+                    writeToArray(T, S);
+                  }))
+
           // --- Elasticity tangents ---
-          .method("convectedTangent!", [](MaterialPoint& mp, itensor4& c) { mp.convectedTangent(c); })
-          .method("materialTangent!", [](MaterialPoint& mp, itensor4& c) { mp.materialTangent(c); })
-          .method("spatialTangent!", [](MaterialPoint& mp, itensor4& c) { mp.spatialTangent(c); })
+          .method("convectedTangent!",
+                  instrumented<MaterialPoint, IM::Tangent>(
+                      [](MaterialPoint& mp, itensor4& c) { mp.convectedTangent(c); }))
+          .method("materialTangent!",
+                  instrumented<MaterialPoint, IM::Tangent>(
+                      [](MaterialPoint& mp, itensor4& c) { mp.materialTangent(c); }))
+          .method("spatialTangent!",
+                  instrumented<MaterialPoint, IM::Tangent>(
+                      [](MaterialPoint& mp, itensor4& c) { mp.spatialTangent(c); }))
+
+          // --- Elasticity tangents, written directly into Julia arrays (3x3x3x3, 6 x 6 Voigt or 21 packed) ---
+          .method("convectedTangent!",
+                  instrumented<MaterialPoint, IM::Tangent>([](MaterialPoint& mp, JuliaTensor4 c) {
+                    itensor4 T;
+                    mp.convectedTangent(T);
+                    writeToArray(T, c);
+                  }))
+          .method("convectedTangent!",
+                  instrumented<MaterialPoint, IM::Tangent>([](MaterialPoint& mp, JuliaTensor c) {
+                    itensor4 T;
+                    mp.convectedTangent(T);
+                    writeToArray(T, c);
+                  }))
+          .method("convectedTangent!",
+                  instrumented<MaterialPoint, IM::Tangent>([](MaterialPoint& mp, JuliaVector c) {
+                    checkTangentLayout<MaterialPoint>(TangentLayout::Packed);
+                    itensor4 T;
+                    mp.convectedTangent(T);
+                    writeToArray(T, c);
+                  }))
+          .method("materialTangent!",
+                  instrumented<MaterialPoint, IM::Tangent>([](MaterialPoint& mp, JuliaTensor4 c) {
+                    itensor4 T;
+                    mp.materialTangent(T);
+                    writeToArray(T, c);
+                  }))
+          .method("spatialTangent!",
+                  instrumented<MaterialPoint, IM::Tangent>([](MaterialPoint& mp, JuliaTensor4 c) {
+                    itensor4 T;
+                    mp.spatialTangent(T);
+                    writeToArray(T, c);
+                  }))
+          .method("spatialTangent!",
+                  instrumented<MaterialPoint, IM::Tangent>([](MaterialPoint& mp, JuliaTensor c) {
+                    itensor4 T;
+                    mp.spatialTangent(T);
+                    writeToArray(T, c);
+                  }))
+          .method("spatialTangent!",
+                  instrumented<MaterialPoint, IM::Tangent>([](MaterialPoint& mp, JuliaVector c) {
+                    checkTangentLayout<MaterialPoint>(TangentLayout::Packed);
+                    itensor4 T;
+                    mp.spatialTangent(T);
+                    writeToArray(T, c);
+                  }))
 
           // --- Tangent contractions ---
           // .method("contractWithAllTangents",
@@ -99,10 +486,27 @@ std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> regis
           .method("volumetricStiffness", [](MaterialPoint& mp) { return mp.volumetricStiffness(); })
 
           // --- Bookkeeping ---
-          .method("commitCurrentState", [](MaterialPoint& mp) { mp.commitCurrentState(); })
-          .method("resetCurrentState", [](MaterialPoint& mp) { mp.resetCurrentState(); })
+          .method("commitCurrentState",
+                  instrumented<MaterialPoint, IM::CommitCurrentState>(
+                      [](MaterialPoint& mp) { mp.commitCurrentState(); }))
+          .method("resetCurrentState",
+                  instrumented<MaterialPoint, IM::ResetCurrentState>([](MaterialPoint& mp) { mp.resetCurrentState(); }))
+          .method("updateCurrentState",
+                  instrumented<MaterialPoint, IM::UpdateCurrentState>(
+                      [](MaterialPoint& mp, double theTime, itensor F) { mp.updateCurrentState(theTime, F); }))
           .method("updateCurrentState",
-                  [](MaterialPoint& mp, double theTime, itensor F) { mp.updateCurrentState(theTime, F); })
+                  instrumented<MaterialPoint, IM::UpdateCurrentState>(
+                      [](MaterialPoint& mp, double theTime, JuliaTensor F) {
+                        mp.updateCurrentState(theTime, toITensor(F));
+                      }))
+
+          // Update, energy, S and convected tangent (3x3x3x3, 6 x 6 Voigt or 21 packed) in one call
+          .method("evaluate!",
+                  instrumented<MaterialPoint, IM::Evaluate>(&evaluateFiniteStrainPoint<MaterialPoint, JuliaTensor4>))
+          .method("evaluate!",
+                  instrumented<MaterialPoint, IM::Evaluate>(&evaluateFiniteStrainPoint<MaterialPoint, JuliaTensor>))
+          .method("evaluate!",
+                  instrumented<MaterialPoint, IM::Evaluate>(&evaluateFiniteStrainPoint<MaterialPoint, JuliaVector>))
 
           // --- Extract state ---
           // For convergedDeformationGradient, we have both const and non-const versions in C++.
@@ -131,6 +535,39 @@ std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> regis
               [](MaterialPoint& mp, double theTime, const itensor& strain) { mp.setConvergedState(theTime, strain); });
   }
 
+  registerFiniteStrainMPBatch<Material, MaterialPoint>(mod, mpName + "Batch");
+
+  // Whole deformation histories of a fresh point, the second Piola-Kirchhoff stress as 6 x steps Voigt matrix or
+  // 3 x 3 x steps array
+  mat.method("drive!", &driveFiniteStrainHistory<Material, MaterialPoint, JuliaTensor>);
+  mat.method("drive!", &driveFiniteStrainHistory<Material, MaterialPoint, JuliaTensorBatch>);
+  mat.method("drive!", &driveFiniteStrainHistory<Material, MaterialPoint, JuliaTensor, JuliaStatus>);
+  mat.method("drive!", &driveFiniteStrainHistory<Material, MaterialPoint, JuliaTensorBatch, JuliaStatus>);
+  mat.method("driveMixed!", &driveFiniteStrainMixedHistory<Material, MaterialPoint>);
+  mat.method("driveMixed!", &driveFiniteStrainMixedHistory<Material, MaterialPoint, JuliaStatus>);
+
+  // Calibration sweeps over a 3 x 3 x steps deformation history, the stresses are second Piola-Kirchhoff
+  registerParameterSweep<Material, 9, JuliaTensorBatch>(
+      mod, name + "Sweep", name,
+      [](const Material& material, size_t steps, const double* times, const double* F, const PointHistoryOutput& out) {
+        return driveFiniteStrainPoint<MaterialPoint>(material, steps, times, F, out);
+      });
+
+  // Stateless evaluation without material points, only for path independent models
+  if constexpr (Hyperelastic<MaterialPoint>::value) {
+    registerHyperelasticEvaluator<Material, MaterialPoint>(mod, name + "Stateless");
+    mat.method("stateless", [](const Material& material) {
+      return jlcxx::create<HyperelasticEvaluator<Material, MaterialPoint>>(material);
+    });
+  }
+
+  // Bulk factory, all points live in one arena owned by the returned batch
+  mat.method("createMaterialPoints", [](const Material& material, jlcxx::cxxint_t n) {
+    if (n < 0)
+      throw std::invalid_argument("Number of material points must not be negative.");
+    return jlcxx::create<FiniteStrainMPBatch<Material, MaterialPoint>>(material, static_cast<size_t>(n));
+  });
+
   return std::make_pair(mat, mp);
 }
 
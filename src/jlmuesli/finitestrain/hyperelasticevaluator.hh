@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <jlmuesli/util/elementkernel.hh>
+#include <jlmuesli/util/layout.hh>
+#include <jlmuesli/util/simdkernels.hh>
+#include <jlmuesli/util/threadpool.hh>
+
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include <muesli/muesli.h>
+
+// Path independent finite-strain models, their response is a function of F alone
+template <typename MaterialPoint>
+struct Hyperelastic : std::false_type
+{};
+
+template <>
+struct Hyperelastic<muesli::neohookeanMP> : std::true_type
+{};
+
+template <>
+struct Hyperelastic<muesli::svkMP> : std::true_type
+{};
+
+template <>
+struct Hyperelastic<muesli::mooneyMP> : std::true_type
+{};
+
+template <>
+struct Hyperelastic<muesli::arrudaboyceMP> : std::true_type
+{};
+
+template <>
+struct Hyperelastic<muesli::yeohMP> : std::true_type
+{};
+
+// Stateless evaluation of a hyperelastic model: maps deformation gradients to energy, stresses and tangents without
+// keeping a material point per point, so nothing has to be stored, committed or reset. Models with a closed-form kernel
+// in simdkernels.hh (Neo-Hooke, SVK) are evaluated by it, provided it reproduced muesli for this material. The others
+// go through one scratch material point per range of points, which is overwritten by every update.
+//
+// Deformation gradients and first Piola-Kirchhoff stresses are 9 column-major components per point, the material
+// tangent dP/dF 81 (see layout.hh). Loops run on ThreadPool::global().
+template <typename Material, typename MaterialPoint>
+class HyperelasticEvaluator
+{
+  static_assert(Hyperelastic<MaterialPoint>::value, "Stateless evaluation needs a path independent model.");
+
+public:
+  explicit HyperelasticEvaluator(const Material& material)
+      : material_(material),
+        kernel_(BatchKernel<MaterialPoint>::parameters(material)) {}
+
+  const Material& material() const { return material_; }
+
+  bool simdKernel() const { return kernel_.has_value(); }
+
+  // Energy, second Piola-Kirchhoff stress and convected tangent of n deformation gradients
+  void evaluate(std::size_t n, const double* F, double* S, std::size_t components, double* C, TangentLayout layout,
+                double* energy) const {
+    const std::size_t stride = tangentComponents(layout);
+    ThreadPool::global().parallelFor(n, batchGrainSize, [&](std::size_t begin, std::size_t end) {
+      if constexpr (BatchKernel<MaterialPoint>::available) {
+        if (kernel_) {
+          BatchKernel<MaterialPoint>::evaluate(*kernel_, end - begin, F + 9 * begin, components,
+                                               S + components * begin, C + stride * begin, layout, energy + begin);
+          return;
+        }
+      }
+      MaterialPoint mp(material_);
+      istensor stress;
+      itensor4 T;
+      for (std::size_t i = begin; i < end; ++i) {
+        mp.updateCurrentState(0.0, itensorFromColumnMajor(F + 9 * i));
+        mp.secondPiolaKirchhoffStress(stress);
+        writeStressComponents(stress, S + components * i, components);
+        mp.convectedTangent(T);
+        writeTangent(T, C + stride * i, layout);
+        energy[i] = mp.storedEnergy();
+      }
+    });
+  }
+
+  // Energy, first Piola-Kirchhoff stress and material tangent dP/dF of n deformation gradients
+  void evaluateFirstPiola(std::size_t n, const double* F, double* P, double* A, double* energy) const {
+    ThreadPool::global().parallelFor(n, batchGrainSize, [&](std::size_t begin, std::size_t end) {
+      if constexpr (BatchKernel<MaterialPoint>::available) {
+        if (kernel_) {
+          std::vector<double> S(9 * (end - begin)), C(81 * (end - begin));
+          BatchKernel<MaterialPoint>::evaluate(*kernel_, end - begin, F + 9 * begin, 9, S.data(), C.data(),
+                                               TangentLayout::Full, energy + begin);
+          for (std::size_t i = begin; i < end; ++i) {
+            const double* Fi = F + 9 * i;
+            const double* Si = S.data() + 9 * (i - begin);
+            for (std::size_t J = 0; J < 3; ++J)
+              for (std::size_t k = 0; k < 3; ++k)
+                P[9 * i + k + 3 * J] = Fi[k] * Si[3 * J] + Fi[k + 3] * Si[1 + 3 * J] + Fi[k + 6] * Si[2 + 3 * J];
+            tangentToArray(Fi, Si, C.data() + 81 * (i - begin), A + 81 * i);
+          }
+          return;
+        }
+      }
+      MaterialPoint mp(material_);
+      itensor stress;
+      itensor4 T;
+      for (std::size_t i = begin; i < end; ++i) {
+        mp.updateCurrentState(0.0, itensorFromColumnMajor(F + 9 * i));
+        mp.firstPiolaKirchhoffStress(stress);
+        writeColumnMajor(stress, P + 9 * i);
+        mp.materialTangent(T);
+        writeColumnMajor(T, A + 81 * i);
+        energy[i] = mp.storedEnergy();
+      }
+    });
+  }
+
+  // Energy of n deformation gradients
+  void storedEnergy(std::size_t n, const double* F, double* energy) const {
+    ThreadPool::global().parallelFor(n, batchGrainSize, [&](std::size_t begin, std::size_t end) {
+      MaterialPoint mp(material_);
+      for (std::size_t i = begin; i < end; ++i) {
+        mp.updateCurrentState(0.0, itensorFromColumnMajor(F + 9 * i));
+        energy[i] = mp.storedEnergy();
+      }
+    });
+  }
+
+private:
+  const Material& material_;
+  std::optional<typename BatchKernel<MaterialPoint>::Parameters> kernel_;
+};
@@ -5,6 +5,7 @@
 
 // #include "finitestrainbindings.hh"
 
+#include <jlmuesli/finitestrain/finitestrainbatch.hh>
 #include <jlmuesli/util/common.hh>
 #include <jlmuesli/util/utils.hh>
 
@@ -21,6 +22,23 @@ template <typename Material, typename MaterialPoint, typename MaterialBase = mue
 std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> registerFiniteStrainMaterial(
     jlcxx::Module& mod, const std::string& name);
 
+// Batch form of setConvergedState: F and be as 3 x 3 x N arrays, iso as vector of length N and kine as 3 x N matrix.
+// The points read their arrays in place.
+inline void setFplasticBatchState(FiniteStrainMPBatch<muesli::fplasticMaterial, muesli::fplasticMP>& batch,
+                                  double theTime, JuliaTensorBatch F, JuliaVector iso, JuliaTensor kine,
+                                  JuliaTensorBatch be) {
+  const size_t n      = batch.size();
+  const double* Fs    = assertBatchSizeAndExtractData(F, 9, n);
+  const double* isos  = assertBatchSizeAndExtractData(iso, 1, n);
+  const double* kines = assertBatchSizeAndExtractData(kine, 3, n);
+  const double* bes   = assertBatchSizeAndExtractData(be, 9, n);
+  batch.setConvergedState([&](muesli::fplasticMP& mp, size_t i) {
+    const double* k = kines + 3 * i;
+    mp.setConvergedState(theTime, itensorFromColumnMajor(Fs + 9 * i), isos[i], ivector(k[0], k[1], k[2]),
+                         istensorFromColumnMajor(bes + 9 * i));
+  });
+}
+
 inline void registerFiniteStrainMaterials(jlcxx::Module& mod) {
   using jlcxx::arg;
   using jlcxx::julia_base_type;
@@ -106,5 +124,6 @@ inline void registerFiniteStrainMaterials(jlcxx::Module& mod) {
     mp.method("setConvergedState",
               [](MaterialPoint& mp, double theTime, const itensor& F, double iso, const ivector& kine,
                  const istensor& be) { mp.setConvergedState(theTime, F, iso, kine, be); });
+    mod.method("setConvergedState!", &setFplasticBatchState);
   }
 }
\ No newline at end of file
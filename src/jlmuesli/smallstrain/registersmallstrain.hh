@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <jlmuesli/smallstrain/smallstrainbatch.hh>
 #include <jlmuesli/util/common.hh>
+#include <jlmuesli/util/convergedstate.hh>
 #include <jlmuesli/util/utils.hh>
 
 #include <muesli/muesli.h>
@@ -19,6 +21,85 @@ template <typename Material, typename MaterialPoint, bool registerConvergedState
 std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> registerSmallStrainMaterial(
     jlcxx::Module& mod, const std::string& name);
 
+// Batch forms of setConvergedState. Strains are passed as 6 x N Voigt matrices (engineering shear) or 3 x 3 x N
+// arrays, scalars as vectors of length N. The points read their arrays in place.
+template <typename StrainArray>
+void setSplasticBatchState(SmallStrainMPBatch<muesli::splasticMaterial, muesli::splasticMP>& batch, double theTime,
+                           StrainArray strain, JuliaVector dg, StrainArray epn, JuliaVector xin, StrainArray Xin) {
+  constexpr size_t c = BatchLayout<StrainArray>::symmetricComponents;
+  const size_t n     = batch.size();
+  const double* e    = assertBatchSizeAndExtractData(strain, c, n);
+  const double* dgs  = assertBatchSizeAndExtractData(dg, 1, n);
+  const double* ep   = assertBatchSizeAndExtractData(epn, c, n);
+  const double* xi   = assertBatchSizeAndExtractData(xin, 1, n);
+  const double* X    = assertBatchSizeAndExtractData(Xin, c, n);
+  batch.setConvergedState([&](muesli::splasticMP& mp, size_t i) {
+    mp.setConvergedState(theTime, strainFromComponents(e + c * i, c), dgs[i], strainFromComponents(ep + c * i, c),
+                         xi[i], strainFromComponents(X + c * i, c));
+  });
+}
+
+template <typename StrainArray>
+void setViscoplasticBatchState(SmallStrainMPBatch<muesli::viscoplasticMaterial, muesli::viscoplasticMP>& batch,
+                               double theTime, JuliaVector dg, StrainArray epn, JuliaVector xin, StrainArray Xin,
+                               StrainArray strain) {
+  constexpr size_t c = BatchLayout<StrainArray>::symmetricComponents;
+  const size_t n     = batch.size();
+  const double* dgs  = assertBatchSizeAndExtractData(dg, 1, n);
+  const double* ep   = assertBatchSizeAndExtractData(epn, c, n);
+  const double* xi   = assertBatchSizeAndExtractData(xin, 1, n);
+  const double* X    = assertBatchSizeAndExtractData(Xin, c, n);
+  const double* e    = assertBatchSizeAndExtractData(strain, c, n);
+  batch.setConvergedState([&](muesli::viscoplasticMP& mp, size_t i) {
+    mp.setConvergedState(theTime, dgs[i], strainFromComponents(ep + c * i, c), xi[i],
+                         strainFromComponents(X + c * i, c), strainFromComponents(e + c * i, c));
+  });
+}
+
+// The viscous strains are nvisco strains per point, i.e. a 6 x nvisco x N or 3 x 3 x nvisco x N array
+template <typename StrainArray, typename ViscousArray>
+void setViscoelasticBatchState(SmallStrainMPBatch<muesli::viscoelasticMaterial, muesli::viscoelasticMP>& batch,
+                               double theTime, StrainArray strain, ViscousArray epsv, StrainArray epsdev,
+                               JuliaVector theta) {
+  constexpr size_t c = BatchLayout<StrainArray>::symmetricComponents;
+  const size_t n     = batch.size();
+  if (n == 0 || epsv.size() == 0 || epsv.size() % (c * n) != 0)
+    throw std::invalid_argument("Viscous strains have to hold nvisco strains for each of the " + std::to_string(n) +
+                                " points.");
+  const size_t nvisco = epsv.size() / (c * n);
+  const double* e     = assertBatchSizeAndExtractData(strain, c, n);
+  const double* v     = epsv.data();
+  const double* dev   = assertBatchSizeAndExtractData(epsdev, c, n);
+  const double* th    = assertBatchSizeAndExtractData(theta, 1, n);
+  batch.setConvergedState([&](muesli::viscoelasticMP& mp, size_t i) {
+    mp.setConvergedState(theTime, strainFromComponents(e + c * i, c), viscousStrains(v + c * nvisco * i, c, nvisco),
+                         strainFromComponents(dev + c * i, c), th[i]);
+  });
+}
+
+// Viscous strains of all points from a borrowed ArrayOfIsTensors holding nvisco consecutive tensors per point
+template <typename StrainArray>
+void setViscoelasticBatchStateFromTensors(
+    SmallStrainMPBatch<muesli::viscoelasticMaterial, muesli::viscoelasticMP>& batch, double theTime,
+    StrainArray strain, const ArrayOfTensorsT<istensor>& epsv, StrainArray epsdev, JuliaVector theta) {
+  constexpr size_t c             = BatchLayout<StrainArray>::symmetricComponents;
+  const size_t n                 = batch.size();
+  const std::vector<istensor>& v = epsv.tensors();
+  if (n == 0 || v.empty() || v.size() % n != 0)
+    throw std::invalid_argument("Viscous strains have to hold nvisco tensors for each of the " + std::to_string(n) +
+                                " points.");
+  const size_t nvisco = v.size() / n;
+  const double* e     = assertBatchSizeAndExtractData(strain, c, n);
+  const double* dev   = assertBatchSizeAndExtractData(epsdev, c, n);
+  const double* th    = assertBatchSizeAndExtractData(theta, 1, n);
+  batch.setConvergedState([&](muesli::viscoelasticMP& mp, size_t i) {
+    std::vector<istensor>& scratch = viscousStrainScratch();
+    scratch.assign(v.begin() + nvisco * i, v.begin() + nvisco * (i + 1));
+    mp.setConvergedState(theTime, strainFromComponents(e + c * i, c), scratch, strainFromComponents(dev + c * i, c),
+                         th[i]);
+  });
+}
+
 inline void registerSmallStrainMaterials(jlcxx::Module& mod) {
   using jlcxx::arg;
   using jlcxx::julia_base_type;
@@ -84,6 +165,8 @@ inline void registerSmallStrainMaterials(jlcxx::Module& mod) {
     mat.method("setConvergedState",
                [](MaterialPoint& mp, const double theTime, const istensor& strain, const double dg, const istensor& epn,
                   const double xin, const istensor& Xin) { mp.setConvergedState(theTime, strain, dg, epn, xin, Xin); });
+    mod.method("setConvergedState!", &setSplasticBatchState<JuliaTensor>);
+    mod.method("setConvergedState!", &setSplasticBatchState<JuliaTensorBatch>);
   }
   {
     using Material      = muesli::viscoelasticMaterial;
@@ -94,12 +177,28 @@ inline void registerSmallStrainMaterials(jlcxx::Module& mod) {
     mat.constructor([](double E, double nu, double rho, size_t nvisco, JuliaVector eta, JuliaVector tau) {
       return new Material{"Viscoelastic", E, nu, rho, nvisco, eta.data(), tau.data()};
     });
+    // The viscous strains are borrowed, or read from a 3 x 3 x nvisco array or a 6 x nvisco Voigt matrix
     mat.method("setConvergedState",
-               [](MaterialPoint& mp, double theTime, const istensor& strain, ArrayOfTensorsT<istensor> epsv_arrays,
+               [](MaterialPoint& mp, double theTime, const istensor& strain, const ArrayOfTensorsT<istensor>& epsv,
                   const istensor& epsdev, const double& theta) {
-                 std::vector<istensor> epsv = epsv_arrays.tensors();
-                 mp.setConvergedState(theTime, strain, epsv, epsdev, theta);
+                 mp.setConvergedState(theTime, strain, epsv.tensors(), epsdev, theta);
                });
+    mat.method("setConvergedState", [](MaterialPoint& mp, double theTime, const istensor& strain,
+                                       JuliaTensorBatch epsv, const istensor& epsdev, const double& theta) {
+      if (epsv.size() == 0 || epsv.size() % 9 != 0)
+        throw std::invalid_argument("Viscous strains have to be a 3 x 3 x nvisco array.");
+      mp.setConvergedState(theTime, strain, viscousStrains(epsv.data(), 9, epsv.size() / 9), epsdev, theta);
+    });
+    mat.method("setConvergedState", [](MaterialPoint& mp, double theTime, const istensor& strain, JuliaTensor epsv,
+                                       const istensor& epsdev, const double& theta) {
+      if (epsv.size() == 0 || epsv.size() % 6 != 0)
+        throw std::invalid_argument("Viscous strains have to be a 6 x nvisco matrix.");
+      mp.setConvergedState(theTime, strain, viscousStrains(epsv.data(), 6, epsv.size() / 6), epsdev, theta);
+    });
+    mod.method("setConvergedState!", &setViscoelasticBatchState<JuliaTensor, JuliaTensorBatch>);
+    mod.method("setConvergedState!", &setViscoelasticBatchState<JuliaTensorBatch, JuliaTensor4>);
+    mod.method("setConvergedState!", &setViscoelasticBatchStateFromTensors<JuliaTensor>);
+    mod.method("setConvergedState!", &setViscoelasticBatchStateFromTensors<JuliaTensorBatch>);
   }
   {
     using Material      = muesli::viscoplasticMaterial;
@@ -115,6 +214,8 @@ inline void registerSmallStrainMaterials(jlcxx::Module& mod) {
     mat.method("setConvergedState",
                [](MaterialPoint& mp, double theTime, double dg, const istensor& epn, double xin, const istensor& Xin,
                   const istensor& strain) { mp.setConvergedState(theTime, dg, epn, xin, Xin, strain); });
+    mod.method("setConvergedState!", &setViscoplasticBatchState<JuliaTensor>);
+    mod.method("setConvergedState!", &setViscoplasticBatchState<JuliaTensorBatch>);
   }
   mod.add_type<muesli::sdamageMaterial>("SdamageMaterial", julia_base_type<muesli::smallStrainMaterial>());
   mod.add_type<muesli::sdamageMP>("SdamageMP", julia_base_type<muesli::smallStrainMP>());
@@ -0,0 +1,211 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <jlmuesli/util/layout.hh>
+#include <jlmuesli/util/mpbatch.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <muesli/muesli.h>
+
+// Batch of small-strain material points. Strains and stresses are passed per point either as 6 Voigt components or
+// as 9 column-major components, tangents in any of the TangentLayouts (see layout.hh). With caching enabled, stress,
+// tangent and energy are memoized.
+template <typename Material, typename MaterialPoint>
+class SmallStrainMPBatch : public MPBatch<Material, MaterialPoint>
+{
+  using Base = MPBatch<Material, MaterialPoint>;
+  using Base::bucketing_;
+  using Base::cache_;
+  using Base::forEachRange;
+  using Base::kernelEnabled_;
+  using Base::plasticity_;
+  using Base::points_;
+  using Base::predictor_;
+
+public:
+  using Base::Base;
+  using Base::size;
+
+  // See MPBatch::configureSubstepping, substeps interpolate the strain linearly
+  void setSubstepping(std::size_t maxLevels, double incrementLimit = 0.0) {
+    const double zero[9] = {};
+    this->configureSubstepping(maxLevels, incrementLimit, zero);
+  }
+
+  void updateCurrentState(double t, const double* strain, std::size_t components) {
+    cache_.invalidate();
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+        updatePoint(i, t, strain, components);
+    });
+  }
+
+  void stress(double* sigma, std::size_t components) const {
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      istensor scratch;
+      ResponseCache::Counter counter(cache_);
+      for (std::size_t i = begin; i < end; ++i) {
+        const istensor& S = cache_.stress(i, scratch, counter, [&](istensor& out) { points_[i].stress(out); });
+        writeStressComponents(S, sigma + i * components, components);
+      }
+    });
+  }
+
+  void tangentTensor(double* C, TangentLayout layout = TangentLayout::Full) const {
+    checkTangentLayout<MaterialPoint>(layout);
+    const std::size_t stride = tangentComponents(layout);
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      itensor4 scratch;
+      ResponseCache::Counter counter(cache_);
+      for (std::size_t i = begin; i < end; ++i) {
+        const itensor4& T = cache_.tangent(i, scratch, counter, [&](itensor4& out) { points_[i].tangentTensor(out); });
+        writeTangent(T, C + stride * i, layout);
+      }
+    });
+  }
+
+  // Element stiffness B^T C B for elements made of consecutive points, see MPBatch::assembleElementStiffness
+  void elementStiffness(const double* dN, const double* weights, std::size_t nodes, std::size_t elements,
+                        double* K) const {
+    const auto tangent = [&](std::size_t i, ResponseCache::Counter& counter, double* A) {
+      itensor4 scratch;
+      const itensor4& C = cache_.tangent(i, scratch, counter, [&](itensor4& out) { points_[i].tangentTensor(out); });
+      tangentToArray(C, A);
+    };
+    this->assembleElementStiffness(dN, weights, nodes, elements, K, tangent);
+  }
+
+  // Updates all points and evaluates stress, tangent and energy in a single sweep. With the vectorized kernel the
+  // points only record the strain and the response is not cached.
+  void evaluate(double t, const double* strain, double* sigma, std::size_t components, double* C, TangentLayout layout,
+                double* energy) {
+    checkTangentLayout<MaterialPoint>(layout);
+    cache_.invalidate();
+    if constexpr (PlasticPredictor<MaterialPoint>::available) {
+      if (bucketing_) {
+        evaluateBucketed(t, strain, sigma, components, C, layout, energy);
+        return;
+      }
+    }
+    if constexpr (BatchKernel<MaterialPoint>::available) {
+      if (kernelEnabled_) {
+        forEachRange([&](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i)
+            updatePoint(i, t, strain, components);
+          this->evaluateKernel(begin, end, strain, components, sigma, components, C, layout, energy);
+          // The kernel evaluates the input, failed points report the response of their converged state instead
+          istensor S;
+          itensor4 T;
+          for (std::size_t i = begin; i < end; ++i)
+            if (this->checkResponse(i, sigma + i * components, components))
+              writeResponse(i, sigma, components, C, layout, energy, S, T);
+        });
+        return;
+      }
+    }
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      istensor S;
+      itensor4 T;
+      for (std::size_t i = begin; i < end; ++i) {
+        updatePoint(i, t, strain, components);
+        writeResponse(i, sigma, components, C, layout, energy, S, T);
+        if (this->checkResponse(i, sigma + i * components, components))
+          writeResponse(i, sigma, components, C, layout, energy, S, T);
+      }
+    });
+  }
+
+private:
+  void evaluateBucketed(double t, const double* strain, double* sigma, std::size_t components, double* C,
+                        TangentLayout layout, double* energy) {
+    // Where the elastic tangent does not depend on the state, points that stayed elastic share the tangent of a
+    // virgin point, probed for every sweep so that it follows changes of the material
+    constexpr bool sharedElastic = PlasticPredictor<MaterialPoint>::constantElasticTangent;
+    const std::size_t stride     = tangentComponents(layout);
+    itensor4 elasticTangent;
+    std::vector<double> elastic;
+    if constexpr (sharedElastic) {
+      MaterialPoint probe(this->material());
+      probe.updateCurrentState(0.0, istensor(0.0, 0.0, 0.0, 0.0, 0.0, 0.0));
+      probe.tangentTensor(elasticTangent);
+      elastic.resize(stride);
+      writeTangent(elasticTangent, elastic.data(), layout);
+    }
+    this->bucketedSweep(
+        [&](std::size_t begin, std::size_t end, unsigned char* plastic) {
+          predictor_.classify(plasticity_, begin, end, strain, components, plastic);
+        },
+        [&](std::size_t i) { updatePoint(i, t, strain, components); },
+        [&](std::size_t i, bool stayedElastic) {
+          istensor S;
+          auto& mp = stressedPoint(i, S);
+          writeStressComponents(S, sigma + i * components, components);
+          energy[i] = mp.storedEnergy();
+          // A point substepped while responding may have yielded after all
+          if (sharedElastic && stayedElastic && (!this->substepping() || this->substeps()[i] == 1)) {
+            std::copy(elastic.begin(), elastic.end(), C + stride * i);
+            cache_.store(i, S, elasticTangent, energy[i]);
+          } else {
+            itensor4 T;
+            mp.tangentTensor(T);
+            writeTangent(T, C + stride * i, layout);
+            cache_.store(i, S, T, energy[i]);
+          }
+          if (this->checkResponse(i, sigma + i * components, components)) {
+            itensor4 T;
+            writeResponse(i, sigma, components, C, layout, energy, S, T);
+          }
+        });
+  }
+
+  // Writes stress, tangent and energy of point i to the outputs of all points and caches them, S and T are scratch
+  void writeResponse(std::size_t i, double* sigma, std::size_t components, double* C, TangentLayout layout,
+                     double* energy, istensor& S, itensor4& T) {
+    auto& mp = stressedPoint(i, S);
+    writeStressComponents(S, sigma + i * components, components);
+    mp.tangentTensor(T);
+    writeTangent(T, C + tangentComponents(layout) * i, layout);
+    energy[i] = mp.storedEnergy();
+    cache_.store(i, S, T, energy[i]);
+  }
+
+  // Updates point i to its strain, see MPBatch::updatePoint and MPBatch::substepPoint
+  void updatePoint(std::size_t i, double t, const double* strain, std::size_t components) {
+    const double* e = strain + i * components;
+    if (this->substepping()) {
+      double x[9];
+      writeColumnMajor(strainFromComponents(e, components), x);
+      this->substepPoint(i, t, x, strainStatus(e, components), &updateTo, &stressFailed);
+      return;
+    }
+    Base::updatePoint(
+        i, [&] { return strainStatus(e, components); },
+        [&](MaterialPoint& mp) { mp.updateCurrentState(t, strainFromComponents(e, components)); });
+  }
+
+  // Writes the stress of point i to S and returns the point. With substepping, a point whose stress is not finite is
+  // updated again in substeps first, see MPBatch::recoverResponse.
+  MaterialPoint& stressedPoint(std::size_t i, istensor& S) {
+    points_[i].stress(S);
+    if (this->substepping() && this->recoverResponse(i, S, &updateTo, &stressFailed))
+      points_[i].stress(S);
+    return points_[i];
+  }
+
+  static void updateTo(MaterialPoint& mp, double t, const double* strain) {
+    mp.updateCurrentState(t, istensorFromColumnMajor(strain));
+  }
+
+  static bool stressFailed(const MaterialPoint& mp) {
+    istensor S;
+    mp.stress(S);
+    double values[9];
+    writeColumnMajor(S, values);
+    return !allFinite(values, 9);
+  }
+};
@@ -1,14 +1,218 @@
 // SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <jlmuesli/capi/batchhandle.hh>
 #include <jlmuesli/smallstrain/registersmallstrain.hh>
+#include <jlmuesli/smallstrain/smallstrainbatch.hh>
 #include <jlmuesli/util/common.hh>
+#include <jlmuesli/util/evaluate.hh>
+#include <jlmuesli/util/instrumentation.hh>
+#include <jlmuesli/util/tangentsymmetry.hh>
 #include <jlmuesli/util/utils.hh>
 
+#include <type_traits>
+
 #include <muesli/muesli.h>
 
 #include <jlcxx/jlcxx.hpp>
 
+template <typename Batch, typename StrainArray>
+void updateSmallStrainBatch(Batch& batch, double t, StrainArray strain) {
+  constexpr size_t components = BatchLayout<StrainArray>::symmetricComponents;
+  batch.updateCurrentState(t, assertBatchSizeAndExtractData(strain, components, batch.size()), components);
+}
+
+template <typename Batch, typename StressArray>
+void smallStrainBatchStress(Batch& batch, StressArray sigma) {
+  constexpr size_t components = BatchLayout<StressArray>::symmetricComponents;
+  batch.stress(assertBatchSizeAndExtractData(sigma, components, batch.size()), components);
+}
+
+template <typename Batch, typename TangentArray>
+void smallStrainBatchTangent(Batch& batch, TangentArray C) {
+  constexpr TangentLayout layout = BatchLayout<TangentArray>::tangent;
+  batch.tangentTensor(assertBatchSizeAndExtractData(C, tangentComponents(layout), batch.size()), layout);
+}
+
+template <typename Batch, typename StrainArray, typename TangentArray>
+void evaluateSmallStrainBatch(Batch& batch, double t, StrainArray strain, StrainArray sigma, TangentArray C,
+                              JuliaVector energy) {
+  constexpr size_t components    = BatchLayout<StrainArray>::symmetricComponents;
+  constexpr TangentLayout layout = BatchLayout<TangentArray>::tangent;
+  const size_t n                 = batch.size();
+  batch.evaluate(t, assertBatchSizeAndExtractData(strain, components, n),
+                 assertBatchSizeAndExtractData(sigma, components, n), components,
+                 assertBatchSizeAndExtractData(C, tangentComponents(layout), n), layout,
+                 assertBatchSizeAndExtractData(energy, 1, n));
+}
+
+// Fused update and evaluation of a single point. Only the outputs selected by flags (EvaluateFlags) are written, the
+// stored energy is returned if requested and 0 otherwise.
+template <typename MaterialPoint, typename TangentArray>
+double evaluateSmallStrainPoint(MaterialPoint& mp, double t, JuliaTensor strain, JuliaTensor sigma, TangentArray C,
+                                jlcxx::cxxint_t flags) {
+  if constexpr (std::is_same_v<TangentArray, JuliaVector>)
+    checkTangentLayout<MaterialPoint>(TangentLayout::Packed);
+  mp.updateCurrentState(t, toIstensor(strain));
+  if (flags & EVAL_STRESS) {
+    istensor S;
+    mp.stress(S);
+    writeToArray(S, sigma);
+  }
+  if (flags & EVAL_TANGENT) {
+    itensor4 T;
+    mp.tangentTensor(T);
+    writeToArray(T, C);
+  }
+  return (flags & EVAL_ENERGY) ? mp.storedEnergy() : 0.0;
+}
+
+// Strain driven history of a single point, see pointdriver.hh. strain and stress hold one column per time. With a
+// status vector the status of every step is recorded instead of throwing. Returns the number of completed steps.
+template <typename Material, typename MaterialPoint, typename StrainArray, typename... Status>
+jlcxx::cxxint_t driveSmallStrainHistory(const Material& material, JuliaVector times, StrainArray strain,
+                                        StrainArray stress, JuliaVector energy, jlcxx::ArrayRef<StateField, 1> fields,
+                                        jlcxx::ArrayRef<jlcxx::cxxint_t, 1> indices, JuliaTensor state,
+                                        jlcxx::cxxint_t flags, Status... status) {
+  constexpr size_t components = BatchLayout<StrainArray>::symmetricComponents;
+  const size_t steps          = times.size();
+  PointHistoryOutput out      = pointHistoryOutput(steps, stress, energy, fields, indices, state, flags);
+  out.status                  = statusData(steps, status...);
+  return driveSmallStrainPoint<MaterialPoint>(material, steps, times.data(),
+                                              assertBatchSizeAndExtractData(strain, components, steps), components,
+                                              out);
+}
+
+// Mixed stress/strain controlled history of a single point, see pointdriver.hh. control holds 6 flags in Voigt order,
+// prescribed, strain and stress one Voigt column per time. Returns the number of converged steps, with a status
+// vector failures are recorded per step instead of thrown.
+template <typename Material, typename MaterialPoint, typename... Status>
+jlcxx::cxxint_t driveSmallStrainMixedHistory(const Material& material, JuliaVector times,
+                                             jlcxx::ArrayRef<jlcxx::cxxint_t, 1> control, JuliaTensor prescribed,
+                                             JuliaTensor strain, JuliaTensor stress, JuliaVector energy,
+                                             jlcxx::ArrayRef<StateField, 1> fields,
+                                             jlcxx::ArrayRef<jlcxx::cxxint_t, 1> indices, JuliaTensor state,
+                                             jlcxx::ArrayRef<jlcxx::cxxint_t, 1> iterations, JuliaVector residual,
+                                             double tolerance, jlcxx::cxxint_t maxIterations, Status... status) {
+  if (maxIterations < 0)
+    throw std::invalid_argument("Number of iterations must not be negative.");
+  const size_t steps = times.size();
+  const auto flags   = controlFlags(control, 6);
+  MixedHistoryOutput out =
+      mixedHistoryOutput(steps, 6, strain, stress, energy, fields, indices, state, iterations, residual);
+  out.status = statusData(steps, status...);
+  return driveSmallStrainMixed<MaterialPoint>(material, steps, times.data(), flags.data(),
+                                              assertBatchSizeAndExtractData(prescribed, 6, steps),
+                                              NewtonOptions{tolerance, static_cast<size_t>(maxIterations)}, out);
+}
+
+template <typename Material, typename MaterialPoint>
+void registerSmallStrainMPBatch(jlcxx::Module& mod, const std::string& name) {
+  using Batch = SmallStrainMPBatch<Material, MaterialPoint>;
+  using IM    = InstrumentedMethod;
+
+  registerInstrumentedType<Batch>(name);
+
+  mod.add_type<Batch>(name)
+      .constructor([](const Material& mat, jlcxx::cxxint_t n) {
+        if (n < 0)
+          throw std::invalid_argument("Number of material points must not be negative.");
+        return new Batch(mat, n);
+      })
+      .method("size", [](const Batch& batch) { return batch.size(); })
+
+      // 1-based access to the points, the returned references carry no finalizer and take all per-point methods
+      .method("materialPoint",
+              [](Batch& batch, jlcxx::cxxint_t i) -> MaterialPoint& {
+                if (i < 1 || static_cast<size_t>(i) > batch.size())
+                  throw std::out_of_range("Index out of range in materialPoint.");
+                return batch[i - 1];
+              })
+
+      // Strains and stresses are either given as 6 x N Voigt matrix or as 3 x 3 x N array
+      .method("updateCurrentState",
+              instrumented<Batch, IM::UpdateCurrentState>(&updateSmallStrainBatch<Batch, JuliaTensor>))
+      .method("updateCurrentState",
+              instrumented<Batch, IM::UpdateCurrentState>(&updateSmallStrainBatch<Batch, JuliaTensorBatch>))
+      .method("stress!", instrumented<Batch, IM::Stress>(&smallStrainBatchStress<Batch, JuliaTensor>))
+      .method("stress!", instrumented<Batch, IM::Stress>(&smallStrainBatchStress<Batch, JuliaTensorBatch>))
+
+      // Tangents are either given as 21 x N packed, 6 x 6 x N Voigt or 3 x 3 x 3 x 3 x N array
+      .method("tangentTensor!", instrumented<Batch, IM::Tangent>(&smallStrainBatchTangent<Batch, JuliaTensor>))
+      .method("tangentTensor!", instrumented<Batch, IM::Tangent>(&smallStrainBatchTangent<Batch, JuliaTensorBatch>))
+      .method("tangentTensor!", instrumented<Batch, IM::Tangent>(&smallStrainBatchTangent<Batch, JuliaTensor4Batch>))
+      .method("storedEnergy!",
+              instrumented<Batch, IM::Energy>([](Batch& batch, JuliaVector energy) {
+                batch.storedEnergy(assertBatchSizeAndExtractData(energy, 1, batch.size()));
+              }))
+      .method("evaluate!",
+              instrumented<Batch, IM::Evaluate>(&evaluateSmallStrainBatch<Batch, JuliaTensor, JuliaTensor>))
+      .method("evaluate!",
+              instrumented<Batch, IM::Evaluate>(&evaluateSmallStrainBatch<Batch, JuliaTensor, JuliaTensorBatch>))
+      .method("evaluate!",
+              instrumented<Batch, IM::Evaluate>(&evaluateSmallStrainBatch<Batch, JuliaTensor, JuliaTensor4Batch>))
+      .method("evaluate!",
+              instrumented<Batch, IM::Evaluate>(&evaluateSmallStrainBatch<Batch, JuliaTensorBatch, JuliaTensor>))
+      .method("evaluate!",
+              instrumented<Batch, IM::Evaluate>(&evaluateSmallStrainBatch<Batch, JuliaTensorBatch, JuliaTensorBatch>))
+      .method("evaluate!",
+              instrumented<Batch, IM::Evaluate>(&evaluateSmallStrainBatch<Batch, JuliaTensorBatch, JuliaTensor4Batch>))
+      .method("commitCurrentState",
+              instrumented<Batch, IM::CommitCurrentState>([](Batch& batch) { batch.commitCurrentState(); }))
+      .method("resetCurrentState",
+              instrumented<Batch, IM::ResetCurrentState>([](Batch& batch) { batch.resetCurrentState(); }))
+      .method("elementStiffness!", instrumented<Batch, IM::Tangent>(&batchElementStiffness<Batch>))
+      .method("exportConvergedState!", &exportBatchState<Batch, JuliaTensor, true>)
+      .method("exportConvergedState!", &exportBatchState<Batch, JuliaVector, true>)
+      .method("exportCurrentState!", &exportBatchState<Batch, JuliaTensor, false>)
+      .method("exportCurrentState!", &exportBatchState<Batch, JuliaVector, false>)
+      .method("importConvergedState!", &importBatchState<Batch, JuliaTensor>)
+      .method("importConvergedState!", &importBatchState<Batch, JuliaVector>)
+      .method("saveConvergedState",
+              [name](const Batch& batch, const std::string& path) { batch.saveConvergedState(path, name); })
+      .method("restoreConvergedState!",
+              [name](Batch& batch, const std::string& path) { batch.restoreConvergedState(path, name); })
+
+      // Optional memoization of stress, tangent and energy between updates
+      .method("setCaching!", [](Batch& batch, bool enabled) { batch.setCaching(enabled); })
+      .method("caching", [](const Batch& batch) { return batch.caching(); })
+      .method("invalidateCache!", [](Batch& batch) { batch.invalidateCache(); })
+      .method("cacheHits", [](const Batch& batch) { return batch.cacheHits(); })
+      .method("cacheMisses", [](const Batch& batch) { return batch.cacheMisses(); })
+      .method("resetCacheCounters!", [](Batch& batch) { batch.resetCacheCounters(); })
+
+      // Vectorized evaluate! kernel, see simdkernels.hh
+      .method("simdKernel", [](const Batch& batch) { return batch.simdKernel(); })
+      .method("setSimdKernel!", [](Batch& batch, bool enabled) { batch.setSimdKernel(enabled); })
+
+      // Elastic/plastic bucketing of evaluate! for the plasticity models, the statistics hold points,
+      // predictedPlastic, plastic and mispredicted for each of the last 1024 sweeps
+      .method("setBucketing!", [](Batch& batch, bool enabled) { batch.setBucketing(enabled); })
+      .method("bucketing", [](const Batch& batch) { return batch.bucketing(); })
+      .method("bucketStatistics", &bucketStatistics<Batch>)
+      .method("resetBucketStatistics!", [](Batch& batch) { batch.resetBucketStatistics(); })
+
+      // Per-point status codes of the last update, see pointstatus.hh
+      .method("setStatusTracking!", [](Batch& batch, bool enabled) { batch.setStatusTracking(enabled); })
+      .method("statusTracking", [](const Batch& batch) { return batch.statusTracking(); })
+      .method("pointStatus!", &pointStatus<Batch>)
+      .method("statusSummary", &statusSummary<Batch>)
+
+      // Local substepping of failing points for the plasticity and damage models, see MPBatch::configureSubstepping.
+      // maxLevels 0 disables it, the statistics hold points, substeps, maxSubsteps and unrecovered of the last sweep.
+      .method("setSubstepping!",
+              [](Batch& batch, jlcxx::cxxint_t maxLevels, double incrementLimit) {
+                batch.setSubstepping(substepLevels(maxLevels), incrementLimit);
+              })
+      .method("substepping", [](const Batch& batch) { return batch.substepping(); })
+      .method("substeps!", &substeps<Batch>)
+      .method("substepStatistics", &substepStatistics<Batch>)
+
+      // Handle for the C API (jlmuesli.h) on this batch, to be released with jlmuesli_batch_destroy while the batch
+      // is alive
+      .method("capiHandle", [](Batch& batch) -> void* { return borrowedBatchHandle(batch); });
+}
+
 template <typename Material, typename MaterialPoint, bool registerConvergedState, typename MaterialBase,
           typename MaterialPointBase>
 std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> registerSmallStrainMaterial(
@@ -18,6 +222,9 @@ std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> regis
   std::string matName = name + "Material";
   std::string mpName  = name + "MP";
 
+  using IM = InstrumentedMethod;
+  registerInstrumentedType<MaterialPoint>(mpName);
+
   auto mat = mod.add_type<Material>(matName, jlcxx::julia_base_type<MaterialBase>());
   mat.method("check", &Material::check);
   mat.method("print", [](Material& mat) {
@@ -45,12 +252,40 @@ std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> regis
           .method("contractWithMixedTangent!", [](MaterialPoint& mp, istensor& CM) { mp.contractWithMixedTangent(CM); })
 
           .method("dissipationTangent!", [](MaterialPoint& mp, itensor4& D) { mp.dissipationTangent(D); })
+          .method("dissipationTangent!",
+                  [](MaterialPoint& mp, JuliaTensor4 D) {
+                    itensor4 T;
+                    mp.dissipationTangent(T);
+                    writeToArray(T, D);
+                  })
 
           .method("plasticSlip", [](MaterialPoint& mp) { return mp.plasticSlip(); })
 
           .method("shearStiffness", [](MaterialPoint& mp) { return mp.shearStiffness(); })
 
-          .method("tangentTensor!", [](MaterialPoint& mp, itensor4& C) { mp.tangentTensor(C); })
+          .method("tangentTensor!",
+                  instrumented<MaterialPoint, IM::Tangent>([](MaterialPoint& mp, itensor4& C) { mp.tangentTensor(C); }))
+          .method("tangentTensor!",
+                  instrumented<MaterialPoint, IM::Tangent>([](MaterialPoint& mp, JuliaTensor4 C) {
+                    itensor4 T;
+                    mp.tangentTensor(T);
+                    writeToArray(T, C);
+                  }))
+          // 6 x 6 Voigt matrix
+          .method("tangentTensor!",
+                  instrumented<MaterialPoint, IM::Tangent>([](MaterialPoint& mp, JuliaTensor C) {
+                    itensor4 T;
+                    mp.tangentTensor(T);
+                    writeToArray(T, C);
+                  }))
+          // 21 entries of the upper triangle of the Voigt matrix
+          .method("tangentTensor!",
+                  instrumented<MaterialPoint, IM::Tangent>([](MaterialPoint& mp, JuliaVector C) {
+                    checkTangentLayout<MaterialPoint>(TangentLayout::Packed);
+                    itensor4 T;
+                    mp.tangentTensor(T);
+                    writeToArray(T, C);
+                  }))
 
           // .method("tangentMatrix",
           //         [](MaterialPoint& mp) {
@@ -70,7 +305,8 @@ std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> regis
 
           .method("kineticPotential", [](MaterialPoint& mp) { return mp.kineticPotential(); })
 
-          .method("storedEnergy", [](MaterialPoint& mp) { return mp.storedEnergy(); })
+          .method("storedEnergy",
+                  instrumented<MaterialPoint, IM::Energy>([](MaterialPoint& mp) { return mp.storedEnergy(); }))
 
           // .method("thermodynamicPotentials",
           //         [](MaterialPoint& mp) {
@@ -86,9 +322,22 @@ std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> regis
           // ----------------------------------------------------------------------
           .method("pressure", [](MaterialPoint& mp) { return mp.pressure(); })
 
-          .method("stress!", [](MaterialPoint& mp, istensor& sigma) { mp.stress(sigma); })
+          .method("stress!",
+                  instrumented<MaterialPoint, IM::Stress>([](MaterialPoint& mp, istensor& sigma) { mp.stress(sigma); }))
+          .method("stress!",
+                  instrumented<MaterialPoint, IM::Stress>([](MaterialPoint& mp, JuliaTensor sigma) {
+                    istensor S;
+                    mp.stress(S);
+                    writeToArray(S, sigma);
+                  }))
 
           .method("deviatoricStress!", [](MaterialPoint& mp, istensor& sigma) { mp.deviatoricStress(sigma); })
+          .method("deviatoricStress!",
+                  [](MaterialPoint& mp, JuliaTensor sigma) {
+                    istensor S;
+                    mp.deviatoricStress(S);
+                    writeToArray(S, sigma);
+                  })
 
           // ----------------------------------------------------------------------
           // Strains / States
@@ -105,12 +354,29 @@ std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> regis
           // ----------------------------------------------------------------------
           // Bookkeeping
           // ----------------------------------------------------------------------
-          .method("commitCurrentState", [](MaterialPoint& mp) { mp.commitCurrentState(); })
+          .method("commitCurrentState",
+                  instrumented<MaterialPoint, IM::CommitCurrentState>(
+                      [](MaterialPoint& mp) { mp.commitCurrentState(); }))
 
-          .method("resetCurrentState", [](MaterialPoint& mp) { mp.resetCurrentState(); })
+          .method("resetCurrentState",
+                  instrumented<MaterialPoint, IM::ResetCurrentState>([](MaterialPoint& mp) { mp.resetCurrentState(); }))
 
           .method("updateCurrentState",
-                  [](MaterialPoint& mp, double t, const istensor& strain) { mp.updateCurrentState(t, strain); });
+                  instrumented<MaterialPoint, IM::UpdateCurrentState>(
+                      [](MaterialPoint& mp, double t, const istensor& strain) { mp.updateCurrentState(t, strain); }))
+          .method("updateCurrentState",
+                  instrumented<MaterialPoint, IM::UpdateCurrentState>(
+                      [](MaterialPoint& mp, double t, JuliaTensor strain) {
+                        mp.updateCurrentState(t, toIstensor(strain));
+                      }))
+
+          // Update, energy, stress and tangent (3x3x3x3, 6 x 6 Voigt or 21 packed) in one call
+          .method("evaluate!",
+                  instrumented<MaterialPoint, IM::Evaluate>(&evaluateSmallStrainPoint<MaterialPoint, JuliaTensor4>))
+          .method("evaluate!",
+                  instrumented<MaterialPoint, IM::Evaluate>(&evaluateSmallStrainPoint<MaterialPoint, JuliaTensor>))
+          .method("evaluate!",
+                  instrumented<MaterialPoint, IM::Evaluate>(&evaluateSmallStrainPoint<MaterialPoint, JuliaVector>));
 
   if constexpr (registerConvergedState) {
     mat.method("setConvergedState", [](MaterialPoint& mp, double theTime, const istensor& strain) {
@@ -118,6 +384,31 @@ std::pair<jlcxx::TypeWrapper<Material>, jlcxx::TypeWrapper<MaterialPoint>> regis
     });
   }
 
+  registerSmallStrainMPBatch<Material, MaterialPoint>(mod, name + "MPBatch");
+
+  // Whole strain histories of a fresh point, strains as 6 x steps Voigt matrix or 3 x 3 x steps array
+  mat.method("drive!", &driveSmallStrainHistory<Material, MaterialPoint, JuliaTensor>);
+  mat.method("drive!", &driveSmallStrainHistory<Material, MaterialPoint, JuliaTensorBatch>);
+  mat.method("drive!", &driveSmallStrainHistory<Material, MaterialPoint, JuliaTensor, JuliaStatus>);
+  mat.method("drive!", &driveSmallStrainHistory<Material, MaterialPoint, JuliaTensorBatch, JuliaStatus>);
+  mat.method("driveMixed!", &driveSmallStrainMixedHistory<Material, MaterialPoint>);
+  mat.method("driveMixed!", &driveSmallStrainMixedHistory<Material, MaterialPoint, JuliaStatus>);
+
+  // Calibration sweeps over a 6 x steps Voigt strain history
+  registerParameterSweep<Material, 6, JuliaTensor>(
+      mod, name + "Sweep", name,
+      [](const Material& material, size_t steps, const double* times, const double* strain,
+         const PointHistoryOutput& out) {
+        return driveSmallStrainPoint<MaterialPoint>(material, steps, times, strain, 6, out);
+      });
+
+  // Bulk factory, all points live in one arena owned by the returned batch
+  mat.method("createMaterialPoints", [](const Material& material, jlcxx::cxxint_t n) {
+    if (n < 0)
+      throw std::invalid_argument("Number of material points must not be negative.");
+    return jlcxx::create<SmallStrainMPBatch<Material, MaterialPoint>>(material, static_cast<size_t>(n));
+  });
+
   return std::make_pair(mat, mp);
 }
 
@@ -0,0 +1,236 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "checkpoint.hh"
+
+#include "layout.hh"
+
+#include <cstring>
+#include <stdexcept>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace {
+constexpr char magic[8]               = "JLMCKPT";
+constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+template <typename T>
+void writeValue(std::ofstream& file, const T& value) {
+  file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readValue(const char*& cursor) {
+  T value;
+  std::memcpy(&value, cursor, sizeof(T));
+  cursor += sizeof(T);
+  return value;
+}
+
+std::size_t paddedLength(std::size_t length) { return (length + 7) / 8 * 8; }
+} // namespace
+
+CheckpointWriter::CheckpointWriter(const std::string& path, const std::string& typeTag, std::size_t n)
+    : file_(path, std::ios::binary | std::ios::trunc),
+      n_(n) {
+  if (!file_)
+    throw std::runtime_error("Could not open " + path + " for writing.");
+
+  file_.write(magic, sizeof(magic));
+  writeValue(file_, version);
+  writeValue(file_, byteOrderMark);
+  writeValue(file_, static_cast<std::uint64_t>(n));
+  writeValue(file_, static_cast<std::uint64_t>(typeTag.size()));
+  const std::string paddedTag = typeTag + std::string(paddedLength(typeTag.size()) - typeTag.size(), '\0');
+  file_.write(paddedTag.data(), paddedTag.size());
+
+  // Placeholder for the offset table, filled in by finish()
+  offsetsPosition_ = file_.tellp();
+  offsets_.reserve(n + 1);
+  offsets_.push_back(0);
+  const std::vector<std::uint64_t> placeholder(n + 1, 0);
+  file_.write(reinterpret_cast<const char*>(placeholder.data()), placeholder.size() * sizeof(std::uint64_t));
+}
+
+void CheckpointWriter::write(const muesli::materialState& state) {
+  if (offsets_.size() > n_)
+    throw std::logic_error("Checkpoint already holds all of its records.");
+
+  const std::uint64_t counts[4] = {state.theDouble.size(), state.theVector.size(), state.theStensor.size(),
+                                   state.theTensor.size()};
+  file_.write(reinterpret_cast<const char*>(&state.theTime), sizeof(double));
+  file_.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+
+  buffer_.assign(state.theDouble.begin(), state.theDouble.end());
+  for (const auto& v : state.theVector)
+    for (std::size_t i = 0; i < 3; ++i)
+      buffer_.push_back(v(i));
+  double values[9];
+  for (const auto& S : state.theStensor) {
+    writeStressVoigt(S, values);
+    buffer_.insert(buffer_.end(), values, values + 6);
+  }
+  for (const auto& T : state.theTensor) {
+    writeColumnMajor(T, values);
+    buffer_.insert(buffer_.end(), values, values + 9);
+  }
+  file_.write(reinterpret_cast<const char*>(buffer_.data()), buffer_.size() * sizeof(double));
+
+  offsets_.push_back(offsets_.back() + sizeof(double) + sizeof(counts) + buffer_.size() * sizeof(double));
+}
+
+void CheckpointWriter::finish() {
+  if (offsets_.size() != n_ + 1)
+    throw std::logic_error("Checkpoint is missing records.");
+  file_.seekp(offsetsPosition_);
+  file_.write(reinterpret_cast<const char*>(offsets_.data()), offsets_.size() * sizeof(std::uint64_t));
+  file_.close();
+  if (!file_)
+    throw std::runtime_error("Writing the checkpoint failed.");
+}
+
+CheckpointReader::CheckpointReader(const std::string& path) {
+#ifndef _WIN32
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Could not open " + path + " for reading.");
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Could not stat " + path + ".");
+  }
+  length_ = static_cast<std::size_t>(info.st_size);
+  if (length_ > 0) {
+    void* mapped = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+      throw std::runtime_error("Could not map " + path + ".");
+    data_ = static_cast<const char*>(mapped);
+  } else
+    ::close(fd);
+#else
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file)
+    throw std::runtime_error("Could not open " + path + " for reading.");
+  fallback_.resize(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(fallback_.data(), fallback_.size());
+  data_   = fallback_.data();
+  length_ = fallback_.size();
+#endif
+
+  try {
+    parseHeader(path);
+  } catch (...) {
+#ifndef _WIN32
+    if (data_)
+      ::munmap(const_cast<char*>(data_), length_);
+#endif
+    throw;
+  }
+}
+
+CheckpointReader::~CheckpointReader() {
+#ifndef _WIN32
+  if (data_)
+    ::munmap(const_cast<char*>(data_), length_);
+#endif
+}
+
+void CheckpointReader::parseHeader(const std::string& path) {
+  const std::size_t fixedHeader = sizeof(magic) + 2 * sizeof(std::uint32_t) + 2 * sizeof(std::uint64_t);
+  if (length_ < fixedHeader || std::memcmp(data_, magic, sizeof(magic)) != 0)
+    throw std::runtime_error(path + " is not a material state checkpoint.");
+
+  const char* cursor = data_ + sizeof(magic);
+  const auto fileVersion = readValue<std::uint32_t>(cursor);
+  if (fileVersion != CheckpointWriter::version)
+    throw std::runtime_error(path + " has checkpoint version " + std::to_string(fileVersion) + ", expected " +
+                             std::to_string(CheckpointWriter::version) + ".");
+  if (readValue<std::uint32_t>(cursor) != byteOrderMark)
+    throw std::runtime_error(path + " was written with a different byte order.");
+
+  // Both sizes come from the file, bound them by its length before any arithmetic on them can overflow
+  const auto count     = readValue<std::uint64_t>(cursor);
+  const auto tagLength = readValue<std::uint64_t>(cursor);
+  if (count >= (length_ - fixedHeader) / sizeof(std::uint64_t) || tagLength > length_ - fixedHeader)
+    throw std::runtime_error(path + " is truncated.");
+  n_                       = static_cast<std::size_t>(count);
+  const std::size_t header = fixedHeader + paddedLength(tagLength) + (n_ + 1) * sizeof(std::uint64_t);
+  if (length_ < header)
+    throw std::runtime_error(path + " is truncated.");
+  typeTag_ = std::string(cursor, tagLength);
+  cursor += paddedLength(tagLength);
+
+  offsets_ = cursor;
+  records_ = cursor + (n_ + 1) * sizeof(std::uint64_t);
+  std::uint64_t end;
+  std::memcpy(&end, offsets_ + n_ * sizeof(std::uint64_t), sizeof(end));
+  if (end > length_ - header)
+    throw std::runtime_error(path + " is truncated.");
+}
+
+muesli::materialState CheckpointReader::state(std::size_t i) const {
+  if (i >= n_)
+    throw std::out_of_range("Index out of range in checkpoint.");
+
+  // The record has to lie between its offset and the next one, which parseHeader bounded by the file length via
+  // the last offset. The counts are checked against the record before anything is allocated or read.
+  std::uint64_t offset, next, end;
+  std::memcpy(&offset, offsets_ + i * sizeof(std::uint64_t), sizeof(offset));
+  std::memcpy(&next, offsets_ + (i + 1) * sizeof(std::uint64_t), sizeof(next));
+  std::memcpy(&end, offsets_ + n_ * sizeof(std::uint64_t), sizeof(end));
+  if (offset > next || next > end)
+    throw std::runtime_error("Corrupt offset of record " + std::to_string(i) + " in checkpoint.");
+  const std::uint64_t recordLength = next - offset;
+  const char* cursor               = records_ + offset;
+
+  std::uint64_t counts[4];
+  const std::uint64_t fixedRecord = sizeof(double) + sizeof(counts);
+  if (recordLength < fixedRecord)
+    throw std::runtime_error("Record " + std::to_string(i) + " in checkpoint is truncated.");
+  muesli::materialState state;
+  state.theTime = readValue<double>(cursor);
+  std::memcpy(counts, cursor, sizeof(counts));
+  cursor += sizeof(counts);
+
+  const std::uint64_t capacity      = (recordLength - fixedRecord) / sizeof(double);
+  const std::uint64_t components[4] = {1, 3, 6, 9};
+  std::uint64_t required             = 0;
+  for (std::size_t c = 0; c < 4; ++c) {
+    if (counts[c] > capacity / components[c] || required + counts[c] * components[c] > capacity)
+      throw std::runtime_error("Record " + std::to_string(i) + " in checkpoint is truncated.");
+    required += counts[c] * components[c];
+  }
+
+  double values[9];
+  const auto readValues = [&](std::size_t count) {
+    std::memcpy(values, cursor, count * sizeof(double));
+    cursor += count * sizeof(double);
+  };
+
+  state.theDouble.resize(counts[0]);
+  for (auto& d : state.theDouble)
+    d = readValue<double>(cursor);
+  state.theVector.reserve(counts[1]);
+  for (std::uint64_t k = 0; k < counts[1]; ++k) {
+    readValues(3);
+    state.theVector.emplace_back(values);
+  }
+  state.theStensor.reserve(counts[2]);
+  for (std::uint64_t k = 0; k < counts[2]; ++k) {
+    readValues(6);
+    state.theStensor.emplace_back(values[0], values[1], values[2], values[3], values[4], values[5]);
+  }
+  state.theTensor.reserve(counts[3]);
+  for (std::uint64_t k = 0; k < counts[3]; ++k) {
+    readValues(9);
+    state.theTensor.push_back(itensorFromColumnMajor(values));
+  }
+  return state;
+}
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <muesli/muesli.h>
+
+// Versioned binary checkpoint of the converged states of a batch of material points.
+//
+// File layout (native byte order):
+//   char[8]   magic "JLMCKPT"
+//   uint32    format version
+//   uint32    byte order mark 0x01020304
+//   uint64    number of points n
+//   uint64    length of the type tag, followed by the tag padded to a multiple of 8 bytes
+//   uint64    offsets[n + 1] of the point records, relative to the first record
+//   records   double theTime, uint64 counts[4] (doubles, vectors, stensors, tensors), then the values: vectors as 3,
+//             symmetric tensors as 6 Voigt and tensors as 9 column-major doubles (see layout.hh)
+class CheckpointWriter
+{
+public:
+  static constexpr std::uint32_t version = 1;
+
+  CheckpointWriter(const std::string& path, const std::string& typeTag, std::size_t n);
+
+  // Appends the record of the next point
+  void write(const muesli::materialState& state);
+
+  // Writes the offset table, has to be called after all n records have been written
+  void finish();
+
+private:
+  std::ofstream file_;
+  std::size_t n_;
+  std::streampos offsetsPosition_;
+  std::vector<std::uint64_t> offsets_;
+  std::vector<double> buffer_;
+};
+
+// Read access to a checkpoint. The file is memory-mapped, records are decoded on demand and state() may be called
+// concurrently from several threads.
+class CheckpointReader
+{
+public:
+  explicit CheckpointReader(const std::string& path);
+  ~CheckpointReader();
+
+  CheckpointReader(const CheckpointReader&)            = delete;
+  CheckpointReader& operator=(const CheckpointReader&) = delete;
+
+  std::size_t size() const { return n_; }
+  const std::string& typeTag() const { return typeTag_; }
+
+  muesli::materialState state(std::size_t i) const;
+
+private:
+  void parseHeader(const std::string& path);
+
+  const char* data_   = nullptr;
+  std::size_t length_ = 0;
+  std::vector<char> fallback_;
+  std::size_t n_ = 0;
+  std::string typeTag_;
+  const char* offsets_ = nullptr;
+  const char* records_ = nullptr;
+};
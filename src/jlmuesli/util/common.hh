@@ -3,13 +3,24 @@
 
 #pragma once
 
+#include <jlmuesli/util/layout.hh>
+#include <jlmuesli/util/parametersweep.hh>
+#include <jlmuesli/util/pointdriver.hh>
+#include <jlmuesli/util/pointstatus.hh>
+#include <jlmuesli/util/statefield.hh>
+#include <jlmuesli/util/utils.hh>
+
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include <muesli/Math/mtensor.h>
 #include <muesli/muesli.h>
 
 #include <jlcxx/array.hpp>
+#include <jlcxx/jlcxx.hpp>
 
 #include <julia.h>
 
@@ -24,6 +35,38 @@ using JuliaTensor  = jlcxx::ArrayRef<double, 2>;
 using JuliaVector  = jlcxx::ArrayRef<double, 1>;
 using JuliaTensor4 = jlcxx::ArrayRef<double, 4>;
 
+// Batched arrays, the last dimension runs over the material points
+using JuliaTensorBatch  = jlcxx::ArrayRef<double, 3>;
+using JuliaTensor4Batch = jlcxx::ArrayRef<double, 5>;
+
+// Per-point or per-step status codes, see pointstatus.hh
+using JuliaStatus = jlcxx::ArrayRef<unsigned char, 1>;
+
+// The per-point layout of a batched array follows from its rank: symmetric tensors are passed as 6 x N Voigt matrix
+// or 3 x 3 x N array, tangents as 21 x N packed, 6 x 6 x N Voigt or 3 x 3 x 3 x 3 x N array (see layout.hh)
+template <typename Array>
+struct BatchLayout;
+
+template <>
+struct BatchLayout<JuliaTensor>
+{
+  static constexpr size_t symmetricComponents = 6;
+  static constexpr TangentLayout tangent      = TangentLayout::Packed;
+};
+
+template <>
+struct BatchLayout<JuliaTensorBatch>
+{
+  static constexpr size_t symmetricComponents = 9;
+  static constexpr TangentLayout tangent      = TangentLayout::Voigt;
+};
+
+template <>
+struct BatchLayout<JuliaTensor4Batch>
+{
+  static constexpr TangentLayout tangent = TangentLayout::Full;
+};
+
 inline const double* assertSizeAndExtractData(JuliaVector c, size_t expectedSize) {
   if (c.size() != expectedSize)
     throw std::invalid_argument("Input has to be a " + std::to_string(expectedSize) + " vector.");
@@ -39,6 +82,227 @@ inline const double* assertSizeAndExtractData(JuliaTensor c, std::pair<size_t, s
   return data;
 }
 
+template <int Dim>
+inline double* assertBatchSizeAndExtractData(jlcxx::ArrayRef<double, Dim> c, size_t componentsPerPoint,
+                                             size_t numberOfPoints) {
+  if (c.size() != componentsPerPoint * numberOfPoints)
+    throw std::invalid_argument("Input has to hold " + std::to_string(componentsPerPoint) +
+                                " entries for each of the " + std::to_string(numberOfPoints) + " material points.");
+  return c.data();
+}
+
+inline size_t stateFieldIndex(jlcxx::cxxint_t k) {
+  if (k < 1)
+    throw std::out_of_range("State field indices start at 1.");
+  return static_cast<size_t>(k - 1);
+}
+
+inline size_t substepLevels(jlcxx::cxxint_t maxLevels) {
+  if (maxLevels < 0)
+    throw std::invalid_argument("The number of substep levels must not be negative.");
+  return static_cast<size_t>(maxLevels);
+}
+
+// Entry k (1-based) of a history field for all points of a batch, as stateFieldComponents(field) x N matrix or, for
+// SF_DOUBLE, as N vector
+template <typename Batch, typename Array, bool converged>
+void exportBatchState(const Batch& batch, StateField field, jlcxx::cxxint_t k, Array out) {
+  batch.exportState(field, stateFieldIndex(k), converged,
+                    assertBatchSizeAndExtractData(out, stateFieldComponents(field), batch.size()));
+}
+
+template <typename Batch, typename Array>
+void importBatchState(Batch& batch, StateField field, jlcxx::cxxint_t k, Array data) {
+  batch.importConvergedState(field, stateFieldIndex(k),
+                             assertBatchSizeAndExtractData(data, stateFieldComponents(field), batch.size()));
+}
+
+// Output of a point driver for a history of the given number of steps. fields and indices (1-based) select the
+// recorded history variables, state receives their values as one column per step. Outputs not selected by flags may
+// be empty arrays.
+template <typename StressArray>
+PointHistoryOutput pointHistoryOutput(size_t steps, StressArray stress, JuliaVector energy,
+                                      jlcxx::ArrayRef<StateField, 1> fields,
+                                      jlcxx::ArrayRef<jlcxx::cxxint_t, 1> indices, JuliaTensor state,
+                                      jlcxx::cxxint_t flags) {
+  if (fields.size() != indices.size())
+    throw std::invalid_argument("Every state field needs an index.");
+  PointHistoryOutput out;
+  out.flags            = static_cast<unsigned>(flags);
+  out.stressComponents = BatchLayout<StressArray>::symmetricComponents;
+  for (size_t j = 0; j < fields.size(); ++j)
+    out.selectors.push_back({fields[j], stateFieldIndex(indices[j])});
+  if (out.flags & EVAL_STRESS)
+    out.stress = assertBatchSizeAndExtractData(stress, out.stressComponents, steps);
+  if (out.flags & EVAL_ENERGY)
+    out.energy = assertBatchSizeAndExtractData(energy, 1, steps);
+  if (!out.selectors.empty())
+    out.state = assertBatchSizeAndExtractData(state, selectedStateComponents(out.selectors), steps);
+  return out;
+}
+
+// Control flags of a mixed controlled driver, nonzero entries mark stress controlled components
+inline std::vector<unsigned char> controlFlags(jlcxx::ArrayRef<jlcxx::cxxint_t, 1> control, size_t components) {
+  if (control.size() != components)
+    throw std::invalid_argument("Control flags have to hold " + std::to_string(components) + " entries.");
+  std::vector<unsigned char> flags(components);
+  for (size_t a = 0; a < components; ++a)
+    flags[a] = control[a] != 0;
+  return flags;
+}
+
+// Output of a mixed controlled driver with components values of x and stress per step, see pointHistoryOutput
+template <typename Array>
+MixedHistoryOutput mixedHistoryOutput(size_t steps, size_t components, Array strain, Array stress, JuliaVector energy,
+                                      jlcxx::ArrayRef<StateField, 1> fields,
+                                      jlcxx::ArrayRef<jlcxx::cxxint_t, 1> indices, JuliaTensor state,
+                                      jlcxx::ArrayRef<jlcxx::cxxint_t, 1> iterations, JuliaVector residual) {
+  static_assert(sizeof(jlcxx::cxxint_t) == sizeof(std::int64_t), "Iteration counts are 64 bit integers.");
+  if (fields.size() != indices.size())
+    throw std::invalid_argument("Every state field needs an index.");
+  MixedHistoryOutput out;
+  for (size_t j = 0; j < fields.size(); ++j)
+    out.selectors.push_back({fields[j], stateFieldIndex(indices[j])});
+  out.strain = assertBatchSizeAndExtractData(strain, components, steps);
+  out.stress = assertBatchSizeAndExtractData(stress, components, steps);
+  out.energy = assertBatchSizeAndExtractData(energy, 1, steps);
+  if (!out.selectors.empty())
+    out.state = assertBatchSizeAndExtractData(state, selectedStateComponents(out.selectors), steps);
+  if (iterations.size() != steps)
+    throw std::invalid_argument("Iterations have to hold one entry per step.");
+  out.iterations = reinterpret_cast<std::int64_t*>(iterations.data());
+  out.residual   = assertBatchSizeAndExtractData(residual, 1, steps);
+  return out;
+}
+
+// Parameter sweep over a shared load history, see parametersweep.hh. The kinematic history (strains or deformation
+// gradients) has kinematicComponents values per time, parameters is a candidates x parameters matrix, stress receives
+// 6 x steps x candidates Voigt stresses and energy steps x candidates values. drive(material, steps, times, input,
+// out) runs the history of one candidate and returns its completed steps. The second evaluate! also computes the
+// misfit of every candidate against 6 x steps reference stresses, the third also their PointStatus.
+template <typename Material, size_t kinematicComponents, typename KinematicArray, typename Drive>
+void registerParameterSweep(jlcxx::Module& mod, const std::string& name, const std::string& materialName,
+                            Drive drive) {
+  using Sweep = ParameterSweep<Material>;
+
+  const auto run = [drive](const Sweep& sweep, JuliaTensor parameters, JuliaVector times, KinematicArray input,
+                           JuliaTensorBatch stress, JuliaTensor energy, const double* reference, double* misfit,
+                           unsigned char* status) {
+    const size_t steps = times.size();
+    if (steps == 0 || energy.size() % steps != 0)
+      throw std::invalid_argument("Energy has to be a " + std::to_string(steps) + " x candidates matrix.");
+    const size_t candidates = energy.size() / steps;
+    if (parameters.size() != candidates * sweep.parameters())
+      throw std::invalid_argument("Parameters have to be a " + std::to_string(candidates) + " x " +
+                                  std::to_string(sweep.parameters()) + " matrix.");
+    const double* kinematics = assertBatchSizeAndExtractData(input, kinematicComponents, steps);
+    sweep.run(candidates, parameters.data(), steps, 6, assertBatchSizeAndExtractData(stress, 6 * steps, candidates),
+              energy.data(), reference, misfit, status, [&](const Material& material, const PointHistoryOutput& out) {
+                return drive(material, steps, times.data(), kinematics, out);
+              });
+  };
+
+  mod.add_type<Sweep>(name)
+      .constructor([materialName](const MaterialProperties& properties) {
+        return new Sweep(materialName, properties.multiMap());
+      })
+      .method("addParameter!", &Sweep::addParameter)
+      .method("parameters", &Sweep::parameters)
+      .method("evaluate!",
+              [run](const Sweep& sweep, JuliaTensor parameters, JuliaVector times, KinematicArray input,
+                    JuliaTensorBatch stress, JuliaTensor energy) {
+                run(sweep, parameters, times, input, stress, energy, nullptr, nullptr, nullptr);
+              })
+      .method("evaluate!", [run](const Sweep& sweep, JuliaTensor parameters, JuliaVector times, KinematicArray input,
+                                 JuliaTensorBatch stress, JuliaTensor energy, JuliaTensor reference,
+                                 JuliaVector misfit) {
+        const size_t steps = times.size();
+        run(sweep, parameters, times, input, stress, energy, assertBatchSizeAndExtractData(reference, 6, steps),
+            assertBatchSizeAndExtractData(misfit, 1, energy.size() / std::max<size_t>(steps, 1)), nullptr);
+      })
+      // With the PointStatus of every candidate, infeasible candidates have misfit +Inf
+      .method("evaluate!", [run](const Sweep& sweep, JuliaTensor parameters, JuliaVector times, KinematicArray input,
+                                 JuliaTensorBatch stress, JuliaTensor energy, JuliaTensor reference,
+                                 JuliaVector misfit, JuliaStatus status) {
+        const size_t steps      = times.size();
+        const size_t candidates = energy.size() / std::max<size_t>(steps, 1);
+        if (status.size() != candidates)
+          throw std::invalid_argument("Status has to hold one entry per candidate.");
+        run(sweep, parameters, times, input, stress, energy, assertBatchSizeAndExtractData(reference, 6, steps),
+            assertBatchSizeAndExtractData(misfit, 1, candidates), status.data());
+      });
+}
+
+// Element stiffness matrices of a batch: K is 3 nodes x 3 nodes x elements, dN the 3 x nodes x N shape function
+// gradients and weights the N quadrature weights. The number of nodes and elements follow from the array sizes.
+template <typename Batch>
+void batchElementStiffness(const Batch& batch, JuliaTensorBatch K, JuliaTensorBatch dN, JuliaVector weights) {
+  const size_t n = batch.size();
+  if (n == 0 || dN.size() == 0 || dN.size() % (3 * n) != 0)
+    throw std::invalid_argument("Shape function gradients have to be a 3 x nodes x " + std::to_string(n) + " array.");
+  const size_t nodes     = dN.size() / (3 * n);
+  const size_t blockSize = 9 * nodes * nodes;
+  if (K.size() % blockSize != 0)
+    throw std::invalid_argument("Stiffness has to be a " + std::to_string(3 * nodes) + " x " +
+                                std::to_string(3 * nodes) + " x elements array.");
+  batch.elementStiffness(dN.data(), assertBatchSizeAndExtractData(weights, 1, n), nodes, K.size() / blockSize,
+                         K.data());
+}
+
+// Bucket statistics of a batch flattened to points, predictedPlastic, plastic and mispredicted per evaluate sweep,
+// for the last MPBatch::bucketStatisticsCapacity sweeps
+template <typename Batch>
+std::vector<std::uint64_t> bucketStatistics(const Batch& batch) {
+  std::vector<std::uint64_t> flat;
+  flat.reserve(4 * batch.bucketStatistics().size());
+  for (const auto& step : batch.bucketStatistics())
+    flat.insert(flat.end(), {step.points, step.predictedPlastic, step.plastic, step.mispredicted});
+  return flat;
+}
+
+// Number of points per PointStatus code after the last sweep of a batch with status tracking
+template <typename Batch>
+std::vector<std::uint64_t> statusSummary(const Batch& batch) {
+  const StatusSummary summary = batch.statusSummary();
+  return {summary.counts.begin(), summary.counts.end()};
+}
+
+// Copies the per-point status of a batch with status tracking to status
+template <typename Batch>
+void pointStatus(const Batch& batch, JuliaStatus status) {
+  if (!batch.statusTracking())
+    throw std::logic_error("Status tracking is not enabled for this batch.");
+  if (status.size() != batch.size())
+    throw std::invalid_argument("Status has to hold one entry per point.");
+  std::copy(batch.status().begin(), batch.status().end(), status.data());
+}
+
+// Copies the substeps of the last update per point of a batch with substepping to substeps
+template <typename Batch>
+void substeps(const Batch& batch, jlcxx::ArrayRef<jlcxx::cxxint_t, 1> substeps) {
+  if (!batch.substepping())
+    throw std::logic_error("Substepping is not enabled for this batch.");
+  if (substeps.size() != batch.size())
+    throw std::invalid_argument("Substeps has to hold one entry per point.");
+  std::copy(batch.substeps().begin(), batch.substeps().end(), substeps.data());
+}
+
+// Substep statistics of the last sweep flattened to points, substeps, maxSubsteps and unrecovered
+template <typename Batch>
+std::vector<std::uint64_t> substepStatistics(const Batch& batch) {
+  const auto statistics = batch.substepStatistics();
+  return {statistics.points, statistics.substeps, statistics.maxSubsteps, statistics.unrecovered};
+}
+
+// Status output of a driver, one entry per step. Drivers called without a status array throw on failure.
+inline unsigned char* statusData(size_t) { return nullptr; }
+
+inline unsigned char* statusData(size_t steps, JuliaStatus status) {
+  if (status.size() != steps)
+    throw std::invalid_argument("Status has to hold one entry per step.");
+  return status.data();
+}
+
 inline auto toIVector(JuliaVector vec) {
   const double* data = assertSizeAndExtractData(vec, 3);
   return ivector{vec.data()};
@@ -107,3 +371,28 @@ inline itensor4 toItensor4(const jlcxx::ArrayRef<double, 4>& array) {
 
   return T;
 }
+
+// Write muesli results directly into Julia owned memory, using the column-major layout described in layout.hh
+inline void writeToArray(const itensor& T, JuliaTensor array) {
+  if (array.size() != 9)
+    throw std::invalid_argument("Output has to be a 3 x 3 matrix.");
+  writeColumnMajor(T, array.data());
+}
+
+inline void writeToArray(const itensor4& C, JuliaTensor4 array) {
+  if (array.size() != 81)
+    throw std::invalid_argument("Output has to be a 3x3x3x3 array.");
+  writeColumnMajor(C, array.data());
+}
+
+inline void writeToArray(const itensor4& C, JuliaTensor voigt) {
+  if (voigt.size() != 36)
+    throw std::invalid_argument("Output has to be a 6 x 6 matrix.");
+  writeVoigt(C, voigt.data());
+}
+
+inline void writeToArray(const itensor4& C, JuliaVector packed) {
+  if (packed.size() != 21)
+    throw std::invalid_argument("Output has to be a 21 vector.");
+  writePacked(C, packed.data());
+}
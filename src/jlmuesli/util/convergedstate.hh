@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <jlmuesli/util/layout.hh>
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <muesli/Finitestrain/fplastic.h>
+#include <muesli/muesli.h>
+
+// Maps a muesli::materialState, as returned by getConvergedState, back onto the model specific setConvergedState
+// overloads. The entries of theDouble, theVector, theStensor and theTensor are taken in the order of the arguments of
+// the corresponding setConvergedState overload. Material points without a specialization cannot be restored.
+// input(state, x) writes the converged strain or deformation gradient as 9 column-major components.
+template <typename MaterialPoint>
+struct ConvergedStateTraits
+{
+  static constexpr bool restorable = false;
+
+  static void restore(MaterialPoint&, const muesli::materialState&) {
+    throw std::logic_error("Restoring the converged state is not supported for this material point type.");
+  }
+};
+
+inline void assertStateLayout(const muesli::materialState& state, std::size_t doubles, std::size_t vectors,
+                              std::size_t stensors, std::size_t tensors) {
+  if (state.theDouble.size() < doubles || state.theVector.size() < vectors || state.theStensor.size() < stensors ||
+      state.theTensor.size() < tensors)
+    throw std::invalid_argument("Material state does not match the layout of the material point.");
+}
+
+// setConvergedState(theTime, strain)
+template <typename MaterialPoint>
+struct SmallStrainElasticStateTraits
+{
+  static constexpr bool restorable = true;
+
+  static void restore(MaterialPoint& mp, const muesli::materialState& state) {
+    assertStateLayout(state, 0, 0, 1, 0);
+    mp.setConvergedState(state.theTime, state.theStensor[0]);
+  }
+
+  static void input(const muesli::materialState& state, double* x) {
+    assertStateLayout(state, 0, 0, 1, 0);
+    writeColumnMajor(state.theStensor[0], x);
+  }
+};
+
+// setConvergedState(theTime, F)
+template <typename MaterialPoint>
+struct FiniteStrainElasticStateTraits
+{
+  static constexpr bool restorable = true;
+
+  static void restore(MaterialPoint& mp, const muesli::materialState& state) {
+    assertStateLayout(state, 0, 0, 0, 1);
+    mp.setConvergedState(state.theTime, state.theTensor[0]);
+  }
+
+  static void input(const muesli::materialState& state, double* x) {
+    assertStateLayout(state, 0, 0, 0, 1);
+    writeColumnMajor(state.theTensor[0], x);
+  }
+};
+
+#define JLMUESLI_SMALL_STRAIN_ELASTIC_STATE(MaterialPoint) \
+  template <>                                              \
+  struct ConvergedStateTraits<MaterialPoint> : SmallStrainElasticStateTraits<MaterialPoint> {};
+
+#define JLMUESLI_FINITE_STRAIN_ELASTIC_STATE(MaterialPoint) \
+  template <>                                               \
+  struct ConvergedStateTraits<MaterialPoint> : FiniteStrainElasticStateTraits<MaterialPoint> {};
+
+JLMUESLI_SMALL_STRAIN_ELASTIC_STATE(muesli::elasticIsotropicMP)
+JLMUESLI_SMALL_STRAIN_ELASTIC_STATE(muesli::elasticAnisotropicMP)
+JLMUESLI_SMALL_STRAIN_ELASTIC_STATE(muesli::elasticOrthotropicMP)
+JLMUESLI_SMALL_STRAIN_ELASTIC_STATE(muesli::elasticTransverselyisotropicMP)
+JLMUESLI_FINITE_STRAIN_ELASTIC_STATE(muesli::neohookeanMP)
+JLMUESLI_FINITE_STRAIN_ELASTIC_STATE(muesli::svkMP)
+JLMUESLI_FINITE_STRAIN_ELASTIC_STATE(muesli::mooneyMP)
+JLMUESLI_FINITE_STRAIN_ELASTIC_STATE(muesli::arrudaboyceMP)
+JLMUESLI_FINITE_STRAIN_ELASTIC_STATE(muesli::yeohMP)
+
+// setConvergedState(theTime, strain, dg, epn, xin, Xin)
+template <>
+struct ConvergedStateTraits<muesli::splasticMP>
+{
+  static constexpr bool restorable = true;
+
+  static void restore(muesli::splasticMP& mp, const muesli::materialState& state) {
+    assertStateLayout(state, 2, 0, 3, 0);
+    mp.setConvergedState(state.theTime, state.theStensor[0], state.theDouble[0], state.theStensor[1],
+                         state.theDouble[1], state.theStensor[2]);
+  }
+
+  static void input(const muesli::materialState& state, double* x) {
+    assertStateLayout(state, 2, 0, 3, 0);
+    writeColumnMajor(state.theStensor[0], x);
+  }
+};
+
+// setConvergedState(theTime, dg, epn, xin, Xin, strain)
+template <>
+struct ConvergedStateTraits<muesli::viscoplasticMP>
+{
+  static constexpr bool restorable = true;
+
+  static void restore(muesli::viscoplasticMP& mp, const muesli::materialState& state) {
+    assertStateLayout(state, 2, 0, 3, 0);
+    mp.setConvergedState(state.theTime, state.theDouble[0], state.theStensor[0], state.theDouble[1],
+                         state.theStensor[1], state.theStensor[2]);
+  }
+
+  static void input(const muesli::materialState& state, double* x) {
+    assertStateLayout(state, 2, 0, 3, 0);
+    writeColumnMajor(state.theStensor[2], x);
+  }
+};
+
+// muesli takes the viscous strains as std::vector, restores fill this per thread vector instead of allocating one
+inline std::vector<istensor>& viscousStrainScratch() {
+  thread_local std::vector<istensor> epsv;
+  return epsv;
+}
+
+// Viscous strains of one point from nvisco consecutive strains of the given number of components (see
+// strainFromComponents), in the per thread scratch vector
+inline const std::vector<istensor>& viscousStrains(const double* data, std::size_t components, std::size_t nvisco) {
+  std::vector<istensor>& epsv = viscousStrainScratch();
+  epsv.resize(nvisco);
+  for (std::size_t k = 0; k < nvisco; ++k)
+    epsv[k] = strainFromComponents(data + components * k, components);
+  return epsv;
+}
+
+// setConvergedState(theTime, strain, epsv[0 .. nvisco - 1], epsdev, theta)
+template <>
+struct ConvergedStateTraits<muesli::viscoelasticMP>
+{
+  static constexpr bool restorable = true;
+
+  static void restore(muesli::viscoelasticMP& mp, const muesli::materialState& state) {
+    assertStateLayout(state, 1, 0, 2, 0);
+    const auto& stensors = state.theStensor;
+    std::vector<istensor>& epsv = viscousStrainScratch();
+    epsv.assign(stensors.begin() + 1, stensors.end() - 1);
+    mp.setConvergedState(state.theTime, stensors.front(), epsv, stensors.back(), state.theDouble[0]);
+  }
+
+  static void input(const muesli::materialState& state, double* x) {
+    assertStateLayout(state, 1, 0, 2, 0);
+    writeColumnMajor(state.theStensor.front(), x);
+  }
+};
+
+// setConvergedState(theTime, F, iso, kine, be)
+template <>
+struct ConvergedStateTraits<muesli::fplasticMP>
+{
+  static constexpr bool restorable = true;
+
+  static void restore(muesli::fplasticMP& mp, const muesli::materialState& state) {
+    assertStateLayout(state, 1, 1, 1, 1);
+    mp.setConvergedState(state.theTime, state.theTensor[0], state.theDouble[0], state.theVector[0],
+                         state.theStensor[0]);
+  }
+
+  static void input(const muesli::materialState& state, double* x) {
+    assertStateLayout(state, 1, 1, 1, 1);
+    writeColumnMajor(state.theTensor[0], x);
+  }
+};
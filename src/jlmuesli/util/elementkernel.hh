@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <muesli/Math/mtensor.h>
+
+// Element stiffness from quadrature point tangents.
+//
+// A quadrature point contributes K[a i, b k] += w * dN_a,J A[i J k L] dN_b,L, where dN holds the shape function
+// gradients (3 x nodes, column-major) and A is a 3x3x3x3 tangent in the column-major layout of layout.hh. K is the
+// 3 nodes x 3 nodes element matrix, column-major, with the degree of freedom (a, i) at row 3 a + i.
+//
+// The contraction is done in two passes: first T[a, i, k, L] = dN_a,J A[i J k L] for every node, then
+// K[a i, b k] += w * T[a, i, k, L] dN_b,L. This costs O(81 nodes + 27 nodes^2) instead of O(81 nodes^2) per point and
+// walks K column by column.
+
+// Small strain: A is the tangent C
+inline void tangentToArray(const itensor4& C, double* A) {
+  for (std::size_t L = 0; L < 3; ++L)
+    for (std::size_t k = 0; k < 3; ++k)
+      for (std::size_t J = 0; J < 3; ++J)
+        for (std::size_t i = 0; i < 3; ++i)
+          A[i + 3 * J + 9 * k + 27 * L] = C(i, J, k, L);
+}
+
+// Finite strain, total Lagrangian: A[i J k L] = F_iI C_IJKL F_kK + delta_ik S_JL, i.e. the push forward of the
+// convected tangent (the B^T C B part) plus the geometric stiffness from the second Piola-Kirchhoff stress
+inline void tangentToArray(const itensor& F, const istensor& S, const itensor4& C, double* A) {
+  double FC[81]; // FC[i J K L] = F_iI C_IJKL
+  for (std::size_t L = 0; L < 3; ++L)
+    for (std::size_t K = 0; K < 3; ++K)
+      for (std::size_t J = 0; J < 3; ++J)
+        for (std::size_t i = 0; i < 3; ++i) {
+          double sum = 0.0;
+          for (std::size_t I = 0; I < 3; ++I)
+            sum += F(i, I) * C(I, J, K, L);
+          FC[i + 3 * J + 9 * K + 27 * L] = sum;
+        }
+
+  for (std::size_t L = 0; L < 3; ++L)
+    for (std::size_t k = 0; k < 3; ++k)
+      for (std::size_t J = 0; J < 3; ++J)
+        for (std::size_t i = 0; i < 3; ++i) {
+          double sum = i == k ? S(J, L) : 0.0;
+          for (std::size_t K = 0; K < 3; ++K)
+            sum += FC[i + 3 * J + 9 * K + 27 * L] * F(k, K);
+          A[i + 3 * J + 9 * k + 27 * L] = sum;
+        }
+}
+
+// Same for column-major F, S and C, the result is the material tangent dP/dF
+inline void tangentToArray(const double* F, const double* S, const double* C, double* A) {
+  double FC[81];
+  for (std::size_t L = 0; L < 3; ++L)
+    for (std::size_t K = 0; K < 3; ++K)
+      for (std::size_t J = 0; J < 3; ++J)
+        for (std::size_t i = 0; i < 3; ++i) {
+          const double* CIJ = C + 3 * J + 9 * K + 27 * L;
+          FC[i + 3 * J + 9 * K + 27 * L] = F[i] * CIJ[0] + F[i + 3] * CIJ[1] + F[i + 6] * CIJ[2];
+        }
+
+  for (std::size_t L = 0; L < 3; ++L)
+    for (std::size_t k = 0; k < 3; ++k)
+      for (std::size_t J = 0; J < 3; ++J)
+        for (std::size_t i = 0; i < 3; ++i) {
+          const double* FCiJ = FC + i + 3 * J + 27 * L;
+          A[i + 3 * J + 9 * k + 27 * L] =
+              (i == k ? S[J + 3 * L] : 0.0) + FCiJ[0] * F[k] + FCiJ[9] * F[k + 3] + FCiJ[18] * F[k + 6];
+        }
+}
+
+// Adds the contribution of one quadrature point, scratch is resized to 27 nodes
+inline void addStiffness(const double* A, const double* dN, std::size_t nodes, double w, double* K,
+                         std::vector<double>& scratch) {
+  scratch.resize(27 * nodes);
+  double* T = scratch.data(); // T[i + 3 k + 9 L + 27 a]
+
+  for (std::size_t a = 0; a < nodes; ++a) {
+    const double* dNa = dN + 3 * a;
+    for (std::size_t L = 0; L < 3; ++L)
+      for (std::size_t k = 0; k < 3; ++k)
+        for (std::size_t i = 0; i < 3; ++i) {
+          const double* Ai = A + i + 9 * k + 27 * L;
+          T[i + 3 * k + 9 * L + 27 * a] = dNa[0] * Ai[0] + dNa[1] * Ai[3] + dNa[2] * Ai[6];
+        }
+  }
+
+  const std::size_t rows = 3 * nodes;
+  for (std::size_t b = 0; b < nodes; ++b) {
+    const double* dNb = dN + 3 * b;
+    for (std::size_t k = 0; k < 3; ++k) {
+      double* column = K + rows * (3 * b + k);
+      for (std::size_t a = 0; a < nodes; ++a) {
+        const double* Ta = T + 3 * k + 27 * a;
+        for (std::size_t i = 0; i < 3; ++i)
+          column[3 * a + i] += w * (Ta[i] * dNb[0] + Ta[i + 9] * dNb[1] + Ta[i + 18] * dNb[2]);
+      }
+    }
+  }
+}
@@ -0,0 +1,13 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Selects the outputs of the fused per-point evaluate! calls, the flags are combined bitwise
+enum EvaluateFlags : unsigned
+{
+  EVAL_ENERGY  = 1,
+  EVAL_STRESS  = 2,
+  EVAL_TANGENT = 4,
+  EVAL_ALL     = EVAL_ENERGY | EVAL_STRESS | EVAL_TANGENT
+};
@@ -2,8 +2,17 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "common.hh"
+#include "evaluate.hh"
+#include "instrumentation.hh"
+#include "simdkernels.hh"
+#include "threadpool.hh"
 #include "utils.hh"
 
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
 #include <muesli/Math/mtensor.h>
 
 void MultiMapWrapper::set(const std::string& key, double value) { m_map.insert({key, value}); }
@@ -40,6 +49,85 @@ void ArrayOfTensorsT<TensorType>::pushTensor(JuliaTensor tensor) {
     tensors_.push_back(toITensor(tensor));
 }
 
+template <typename TensorType>
+ArrayOfTensorsT<TensorType>::ArrayOfTensorsT(JuliaTensorBatch tensors) {
+  append(tensors);
+}
+
+template <typename TensorType>
+ArrayOfTensorsT<TensorType>::ArrayOfTensorsT(JuliaTensor voigt) {
+  append(voigt);
+}
+
+template <typename TensorType>
+void ArrayOfTensorsT<TensorType>::append(JuliaTensorBatch tensors) {
+  if (tensors.size() % 9 != 0)
+    throw std::invalid_argument("Tensors have to be a 3 x 3 x N array.");
+  appendComponents(tensors.data(), 9, tensors.size() / 9);
+}
+
+template <typename TensorType>
+void ArrayOfTensorsT<TensorType>::append(JuliaTensor voigt) {
+  if constexpr (!std::is_same_v<TensorType, istensor>)
+    throw std::invalid_argument("Voigt components are only accepted for symmetric tensors.");
+  if (voigt.size() % 6 != 0)
+    throw std::invalid_argument("Voigt components have to be a 6 x N matrix.");
+  appendComponents(voigt.data(), 6, voigt.size() / 6);
+}
+
+template <typename TensorType>
+void ArrayOfTensorsT<TensorType>::appendComponents(const double* data, size_t components, size_t n) {
+  // Grow geometrically, so repeated appends stay linear
+  if (tensors_.size() + n > tensors_.capacity())
+    tensors_.reserve(std::max(tensors_.size() + n, 2 * tensors_.capacity()));
+  for (size_t k = 0; k < n; ++k) {
+    if constexpr (std::is_same_v<TensorType, istensor>)
+      tensors_.push_back(strainFromComponents(data + components * k, components));
+    else
+      tensors_.push_back(itensorFromColumnMajor(data + 9 * k));
+  }
+}
+
+template <typename TensorType>
+void ArrayOfTensorsT<TensorType>::reserve(size_t n) {
+  tensors_.reserve(n);
+}
+
+namespace {
+
+// Whether muesli stores the components of a symmetric tensor as 9 contiguous doubles in column-major order. Tensor
+// classes with a vtable or other members are not, view() then refuses instead of the module failing to build.
+bool symmetricStorageIsColumnMajor() {
+  if constexpr (sizeof(istensor) != 9 * sizeof(double) || !std::is_standard_layout_v<istensor>)
+    return false;
+  const istensor probe(1.0, 2.0, 3.0, 4.0, 5.0, 6.0);
+  double expected[9];
+  writeColumnMajor(probe, expected);
+  return std::equal(expected, expected + 9, reinterpret_cast<const double*>(&probe));
+}
+
+} // namespace
+
+template <typename TensorType>
+jlcxx::ArrayRef<double, 3> ArrayOfTensorsT<TensorType>::view() {
+  if constexpr (!std::is_same_v<TensorType, istensor>)
+    throw std::logic_error("Only symmetric tensors can be viewed without copying, use tensors! instead.");
+  else {
+    static const bool columnMajor = symmetricStorageIsColumnMajor();
+    if (!columnMajor)
+      throw std::logic_error("Symmetric tensors are not stored column-major, use tensors! instead.");
+    return jlcxx::make_julia_array(reinterpret_cast<double*>(tensors_.data()), 3, 3, tensors_.size());
+  }
+}
+
+template <typename TensorType>
+void ArrayOfTensorsT<TensorType>::copyTo(JuliaTensorBatch out) const {
+  if (out.size() != 9 * tensors_.size())
+    throw std::invalid_argument("Output has to be a 3 x 3 x " + std::to_string(tensors_.size()) + " array.");
+  for (size_t k = 0; k < tensors_.size(); ++k)
+    writeColumnMajor(tensors_[k], out.data() + 9 * k);
+}
+
 template <typename TensorType>
 void ArrayOfTensorsT<TensorType>::clear() {
   tensors_.clear();
@@ -61,11 +149,29 @@ template class ArrayOfTensorsT<istensor>;
 template <typename TensorType>
 void registerArrayOfTensorsT(jlcxx::Module& mod, const std::string& name) {
   using TensorWrapper = ArrayOfTensorsT<TensorType>;
-  mod.add_type<TensorWrapper>(name)
-      .template constructor<>()
+  auto wrapper = mod.add_type<TensorWrapper>(name);
+  wrapper.template constructor<>()
+      .template constructor<typename TensorWrapper::JuliaTensorBatch>()
       .method("push!", &TensorWrapper::pushTensor)
+      .method("append!", [](TensorWrapper& tensors, typename TensorWrapper::JuliaTensorBatch data) {
+        tensors.append(data);
+      })
+      .method("sizehint!", [](TensorWrapper& tensors, jlcxx::cxxint_t n) {
+        if (n < 0)
+          throw std::invalid_argument("Capacity must not be negative.");
+        tensors.reserve(static_cast<size_t>(n));
+      })
+      // Column-major copy of all tensors
+      .method("tensors!", &TensorWrapper::copyTo)
       .method("clear!", &TensorWrapper::clear)
       .method("size", &TensorWrapper::size);
+  if constexpr (std::is_same_v<TensorType, istensor>) {
+    wrapper.constructor([](typename TensorWrapper::JuliaTensor voigt) { return new TensorWrapper(voigt); })
+        .method("append!", [](TensorWrapper& tensors, typename TensorWrapper::JuliaTensor voigt) {
+          tensors.append(voigt);
+        })
+        .method("view", &TensorWrapper::view);
+  }
 }
 
 void registerHelpers(jlcxx::Module& mod) {
@@ -80,4 +186,41 @@ void registerHelpers(jlcxx::Module& mod) {
 
   registerArrayOfTensorsT<istensor>(mod, "ArrayOfIsTensors");
   registerArrayOfTensorsT<itensor>(mod, "ArrayOfITensors");
+
+  // Worker pool used by the material point batches, 0 selects one thread per hardware thread
+  mod.method("setNumberOfThreads!", [](jlcxx::cxxint_t n) {
+    if (n < 0)
+      throw std::invalid_argument("Number of threads must not be negative.");
+    ThreadPool::global().resize(n);
+  });
+  mod.method("numberOfThreads", []() { return ThreadPool::global().size(); });
+
+  // Instruction set used by the vectorized batch kernels on this CPU
+  mod.method("simdInstructionSet", []() { return std::string(simdInstructionSet()); });
+
+  // Output selection of the fused per-point evaluate! calls, combined with |
+  mod.set_const("EVAL_ENERGY", static_cast<jlcxx::cxxint_t>(EVAL_ENERGY));
+  mod.set_const("EVAL_STRESS", static_cast<jlcxx::cxxint_t>(EVAL_STRESS));
+  mod.set_const("EVAL_TANGENT", static_cast<jlcxx::cxxint_t>(EVAL_TANGENT));
+  mod.set_const("EVAL_ALL", static_cast<jlcxx::cxxint_t>(EVAL_ALL));
+
+  // Instrumentation, the statistics stay empty unless built with JLMUESLI_ENABLE_INSTRUMENTATION. Methods are named
+  // updateCurrentState, commitCurrentState, resetCurrentState, stress, tangent, energy and evaluate.
+  mod.method("instrumentationEnabled", []() { return Instrumentation::enabled; });
+  mod.method("instrumentedTypes", []() { return Instrumentation::types(); });
+  mod.method("instrumentationCalls", [](const std::string& type, const std::string& method) {
+    return Instrumentation::find(type, method).calls.load();
+  });
+  mod.method("instrumentationSeconds", [](const std::string& type, const std::string& method) {
+    return 1.0e-9 * static_cast<double>(Instrumentation::find(type, method).nanoseconds.load());
+  });
+  mod.method("instrumentationHistogram", [](const std::string& type, const std::string& method) {
+    const MethodStatistics& statistics = Instrumentation::find(type, method);
+    std::vector<std::uint64_t> histogram;
+    for (const auto& count : statistics.histogram)
+      histogram.push_back(count.load());
+    return histogram;
+  });
+  mod.method("instrumentationReport", []() { return Instrumentation::report(); });
+  mod.method("resetInstrumentation!", []() { Instrumentation::reset(); });
 }
@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "instrumentation.hh"
+
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+std::mutex registryMutex;
+
+// A deque never moves its elements, the atomics in TypeStatistics are neither copyable nor movable
+std::deque<TypeStatistics>& registry() {
+  static std::deque<TypeStatistics> types;
+  return types;
+}
+
+std::size_t bucketOf(std::uint64_t ns) {
+  std::size_t bucket = 0;
+  while (ns > 1 && bucket + 1 < histogramBuckets) {
+    ns >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+} // namespace
+
+void MethodStatistics::record(std::uint64_t ns) {
+  calls.fetch_add(1, std::memory_order_relaxed);
+  nanoseconds.fetch_add(ns, std::memory_order_relaxed);
+  histogram[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void MethodStatistics::reset() {
+  calls.store(0, std::memory_order_relaxed);
+  nanoseconds.store(0, std::memory_order_relaxed);
+  for (auto& count : histogram)
+    count.store(0, std::memory_order_relaxed);
+}
+
+TypeStatistics& Instrumentation::add(const std::string& name) {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  for (auto& type : registry())
+    if (type.name == name)
+      return type;
+  auto& type = registry().emplace_back();
+  type.name  = name;
+  return type;
+}
+
+std::vector<std::string> Instrumentation::types() {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  std::vector<std::string> names;
+  for (const auto& type : registry())
+    names.push_back(type.name);
+  return names;
+}
+
+const MethodStatistics& Instrumentation::find(const std::string& type, const std::string& method) {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  for (auto& statistics : registry()) {
+    if (statistics.name != type)
+      continue;
+    for (std::size_t m = 0; m < instrumentedMethods; ++m)
+      if (method == methodName(static_cast<InstrumentedMethod>(m)))
+        return statistics.methods[m];
+    throw std::invalid_argument("Unknown instrumented method " + method + ".");
+  }
+  throw std::invalid_argument("Unknown instrumented type " + type + ".");
+}
+
+void Instrumentation::reset() {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  for (auto& type : registry())
+    for (auto& method : type.methods)
+      method.reset();
+}
+
+std::string Instrumentation::report() {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  std::ostringstream out;
+  out << "type,method,calls,seconds,histogram\n";
+  for (const auto& type : registry())
+    for (std::size_t m = 0; m < instrumentedMethods; ++m) {
+      const MethodStatistics& method = type.methods[m];
+      const std::uint64_t calls      = method.calls.load(std::memory_order_relaxed);
+      if (calls == 0)
+        continue;
+      out << type.name << ',' << methodName(static_cast<InstrumentedMethod>(m)) << ',' << calls << ','
+          << 1.0e-9 * static_cast<double>(method.nanoseconds.load(std::memory_order_relaxed)) << ',';
+      for (std::size_t b = 0; b < histogramBuckets; ++b)
+        out << (b > 0 ? " " : "") << method.histogram[b].load(std::memory_order_relaxed);
+      out << '\n';
+    }
+  return out.str();
+}
+
+const char* Instrumentation::methodName(InstrumentedMethod method) {
+  switch (method) {
+    case InstrumentedMethod::UpdateCurrentState:
+      return "updateCurrentState";
+    case InstrumentedMethod::CommitCurrentState:
+      return "commitCurrentState";
+    case InstrumentedMethod::ResetCurrentState:
+      return "resetCurrentState";
+    case InstrumentedMethod::Stress:
+      return "stress";
+    case InstrumentedMethod::Tangent:
+      return "tangent";
+    case InstrumentedMethod::Energy:
+      return "energy";
+    case InstrumentedMethod::Evaluate:
+      return "evaluate";
+  }
+  return "unknown";
+}
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Call counts, cumulative time and a latency histogram per wrapped type and method. Recording is only compiled in
+// when JLMUESLI_INSTRUMENTATION is defined (CMake option JLMUESLI_ENABLE_INSTRUMENTATION), otherwise instrumented()
+// returns the wrapped function unchanged and the statistics stay empty.
+
+enum class InstrumentedMethod
+{
+  UpdateCurrentState,
+  CommitCurrentState,
+  ResetCurrentState,
+  Stress,
+  Tangent,
+  Energy,
+  Evaluate
+};
+
+inline constexpr std::size_t instrumentedMethods = 7;
+
+// Bucket b counts calls that took between 2^b and 2^(b + 1) nanoseconds
+inline constexpr std::size_t histogramBuckets = 32;
+
+struct MethodStatistics
+{
+  std::atomic<std::uint64_t> calls{0};
+  std::atomic<std::uint64_t> nanoseconds{0};
+  std::atomic<std::uint64_t> histogram[histogramBuckets] = {};
+
+  void record(std::uint64_t ns);
+  void reset();
+};
+
+struct TypeStatistics
+{
+  std::string name;
+  MethodStatistics methods[instrumentedMethods];
+
+  MethodStatistics& operator[](InstrumentedMethod method) { return methods[static_cast<std::size_t>(method)]; }
+};
+
+// Registry of all instrumented types. Entries are never removed, so references stay valid.
+class Instrumentation
+{
+public:
+#ifdef JLMUESLI_INSTRUMENTATION
+  static constexpr bool enabled = true;
+#else
+  static constexpr bool enabled = false;
+#endif
+
+  // Returns the statistics for name, creating them on first use
+  static TypeStatistics& add(const std::string& name);
+
+  static std::vector<std::string> types();
+
+  // Throws std::invalid_argument for unknown types or methods
+  static const MethodStatistics& find(const std::string& type, const std::string& method);
+
+  static void reset();
+
+  // CSV with the columns type,method,calls,seconds,histogram (buckets separated by spaces), one row per used method
+  static std::string report();
+
+  static const char* methodName(InstrumentedMethod method);
+};
+
+template <typename T>
+struct InstrumentedType
+{
+  static inline TypeStatistics* statistics = nullptr;
+};
+
+// Called by the registration templates, T is the wrapped material point or batch type
+template <typename T>
+void registerInstrumentedType(const std::string& name) {
+  InstrumentedType<T>::statistics = &Instrumentation::add(name);
+}
+
+class ScopedTimer
+{
+public:
+  explicit ScopedTimer(MethodStatistics* statistics)
+      : statistics_(statistics),
+        start_(std::chrono::steady_clock::now()) {}
+
+  ~ScopedTimer() {
+    if (!statistics_)
+      return;
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    statistics_->record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  }
+
+  ScopedTimer(const ScopedTimer&)            = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+  MethodStatistics* statistics_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+template <typename T, InstrumentedMethod method, typename F, typename R, typename... Args>
+auto instrumentedImpl(F f) {
+  return [f](Args... args) -> R {
+    TypeStatistics* statistics = InstrumentedType<T>::statistics;
+    const ScopedTimer timer(statistics ? &(*statistics)[method] : nullptr);
+    return f(std::forward<Args>(args)...);
+  };
+}
+
+template <typename T, InstrumentedMethod method, typename F, typename R, typename... Args>
+auto instrumentedLambda(F f, R (F::*)(Args...) const) {
+  return instrumentedImpl<T, method, F, R, Args...>(std::move(f));
+}
+
+// Wraps a binding lambda or function such that its calls are recorded for type T. The returned lambda has the same
+// signature, so jlcxx sees no difference.
+template <typename T, InstrumentedMethod method, typename F>
+auto instrumented(F f) {
+#ifdef JLMUESLI_INSTRUMENTATION
+  return instrumentedLambda<T, method>(std::move(f), &F::operator());
+#else
+  return f;
+#endif
+}
+
+template <typename T, InstrumentedMethod method, typename R, typename... Args>
+auto instrumented(R (*f)(Args...)) {
+#ifdef JLMUESLI_INSTRUMENTATION
+  return instrumentedImpl<T, method, R (*)(Args...), R, Args...>(f);
+#else
+  return f;
+#endif
+}
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+#include <muesli/Math/mtensor.h>
+
+// Conversions between muesli tensors and raw (Julia owned) memory. Everything in here works on plain pointers and
+// does not depend on julia.h, so it can be used from the batch engines as well.
+//
+// Layouts:
+//  - Full 3x3 tensors are stored column-major, i.e. A[i, j] lives at data[i + 3 * j].
+//  - Full 3x3x3x3 tensors are stored column-major, i.e. C[i, j, k, l] lives at data[i + 3 * j + 9 * k + 27 * l].
+//  - Voigt vectors use the ordering (11, 22, 33, 23, 13, 12). Strains carry engineering shear components (2 * e_ij),
+//    stresses do not.
+//  - Voigt tangents are 6x6 matrices in the same ordering, stored column-major, such that stress = C * strain holds
+//    for the Voigt vectors above.
+//  - Packed tangents hold the 21 entries of the upper triangle of the Voigt matrix, row by row, i.e.
+//    (C11, C12, ..., C16, C22, ..., C26, ..., C66). They are only valid for tangents with major symmetry, see
+//    tangentsymmetry.hh. Debug builds check every packed tangent.
+
+enum class TangentLayout
+{
+  Full,
+  Voigt,
+  Packed
+};
+
+inline constexpr std::size_t tangentComponents(TangentLayout layout) {
+  return layout == TangentLayout::Full ? 81 : (layout == TangentLayout::Voigt ? 36 : 21);
+}
+
+inline constexpr std::size_t voigtIndex[6][2] = {
+    {0, 0},
+    {1, 1},
+    {2, 2},
+    {1, 2},
+    {0, 2},
+    {0, 1}
+};
+
+// Uses the same components as toIstensor in common.hh
+inline istensor istensorFromColumnMajor(const double* data) {
+  return istensor(data[0], data[4], data[8], data[5], data[6], data[1]);
+}
+
+inline itensor itensorFromColumnMajor(const double* data) {
+  return itensor(data[0], data[3], data[6], // Row 1
+                 data[1], data[4], data[7], // Row 2
+                 data[2], data[5], data[8]  // Row 3
+  );
+}
+
+inline istensor strainFromVoigt(const double* data) {
+  return istensor(data[0], data[1], data[2], 0.5 * data[3], 0.5 * data[4], 0.5 * data[5]);
+}
+
+// Reads a symmetric strain tensor either from 6 Voigt components or from 9 column-major components
+inline istensor strainFromComponents(const double* data, std::size_t components) {
+  return components == 6 ? strainFromVoigt(data) : istensorFromColumnMajor(data);
+}
+
+inline void writeColumnMajor(const itensor& T, double* out) {
+  for (std::size_t j = 0; j < 3; ++j)
+    for (std::size_t i = 0; i < 3; ++i)
+      out[i + 3 * j] = T(i, j);
+}
+
+inline void writeColumnMajor(const itensor4& C, double* out) {
+  for (std::size_t l = 0; l < 3; ++l)
+    for (std::size_t k = 0; k < 3; ++k)
+      for (std::size_t j = 0; j < 3; ++j)
+        for (std::size_t i = 0; i < 3; ++i)
+          out[i + 3 * j + 9 * k + 27 * l] = C(i, j, k, l);
+}
+
+inline void writeStressVoigt(const istensor& S, double* out) {
+  for (std::size_t a = 0; a < 6; ++a)
+    out[a] = S(voigtIndex[a][0], voigtIndex[a][1]);
+}
+
+// Writes a symmetric stress tensor either as 6 Voigt components or as 9 column-major components
+inline void writeStressComponents(const istensor& S, double* out, std::size_t components) {
+  if (components == 6)
+    writeStressVoigt(S, out);
+  else
+    writeColumnMajor(S, out);
+}
+
+// Voigt entry of a tangent, averaged over the minor symmetries so that only the symmetric part is reported
+inline double voigtEntry(const itensor4& C, std::size_t a, std::size_t b) {
+  const std::size_t i = voigtIndex[a][0], j = voigtIndex[a][1];
+  const std::size_t k = voigtIndex[b][0], l = voigtIndex[b][1];
+  return 0.25 * (C(i, j, k, l) + C(j, i, k, l) + C(i, j, l, k) + C(j, i, l, k));
+}
+
+inline void writeVoigt(const itensor4& C, double* out) {
+  for (std::size_t b = 0; b < 6; ++b)
+    for (std::size_t a = 0; a < 6; ++a)
+      out[a + 6 * b] = voigtEntry(C, a, b);
+}
+
+// Whether the Voigt matrix of C is symmetric up to a relative tolerance
+inline bool hasMajorSymmetry(const itensor4& C, double tolerance = 1e-8) {
+  double scale = 0.0, asymmetry = 0.0;
+  for (std::size_t a = 0; a < 6; ++a)
+    for (std::size_t b = a; b < 6; ++b) {
+      const double upper = voigtEntry(C, a, b), lower = voigtEntry(C, b, a);
+      scale              = std::max(scale, std::abs(upper));
+      asymmetry          = std::max(asymmetry, std::abs(upper - lower));
+    }
+  return asymmetry <= tolerance * scale;
+}
+
+inline void writePacked(const itensor4& C, double* out) {
+#ifndef NDEBUG
+  if (!hasMajorSymmetry(C))
+    throw std::invalid_argument("Tangent has no major symmetry, it cannot be written in the packed layout.");
+#endif
+  for (std::size_t a = 0; a < 6; ++a)
+    for (std::size_t b = a; b < 6; ++b)
+      *out++ = voigtEntry(C, a, b);
+}
+
+inline void writeTangent(const itensor4& C, double* out, TangentLayout layout) {
+  switch (layout) {
+    case TangentLayout::Full:
+      writeColumnMajor(C, out);
+      break;
+    case TangentLayout::Voigt:
+      writeVoigt(C, out);
+      break;
+    case TangentLayout::Packed:
+      writePacked(C, out);
+      break;
+  }
+}
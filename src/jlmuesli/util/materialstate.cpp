@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include "pointstatus.hh"
+#include "statefield.hh"
 #include "utils.hh"
 
 #include <muesli/Math/mtensor.h>
@@ -8,6 +10,21 @@
 void registerMaterialState(jlcxx::Module& mod) {
   using namespace muesli;
 
+  // Selects a container of materialState for the bulk export / import on batches
+  mod.add_bits<StateField>("StateField", jlcxx::julia_type("CppEnum"));
+  mod.set_const("SF_DOUBLE", SF_DOUBLE);
+  mod.set_const("SF_VECTOR", SF_VECTOR);
+  mod.set_const("SF_STENSOR", SF_STENSOR);
+  mod.set_const("SF_TENSOR", SF_TENSOR);
+
+  // Status codes written by batches with status tracking and by the drivers, the status arrays hold UInt8
+  mod.set_const("PS_CONVERGED", static_cast<unsigned char>(PS_CONVERGED));
+  mod.set_const("PS_ITERATIONS_EXCEEDED", static_cast<unsigned char>(PS_ITERATIONS_EXCEEDED));
+  mod.set_const("PS_NEGATIVE_JACOBIAN", static_cast<unsigned char>(PS_NEGATIVE_JACOBIAN));
+  mod.set_const("PS_FULLY_DAMAGED", static_cast<unsigned char>(PS_FULLY_DAMAGED));
+  mod.set_const("PS_NON_FINITE", static_cast<unsigned char>(PS_NON_FINITE));
+  mod.set_const("PS_FAILED", static_cast<unsigned char>(PS_FAILED));
+
   mod.add_type<materialState>("materialState")
       // Default constructor
       .constructor<>()
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Constructs N material points of one type back to back in a single aligned allocation. The points are never moved
+// or assigned, which also allows muesli types that are not move-assignable (they hold references to their material).
+// replace() copy-constructs a point in place instead. Should that copy throw, the slot is left dead: it is skipped on
+// destruction and must not be accessed until a later replace() succeeds.
+template <typename MaterialPoint>
+class MaterialPointArena
+{
+public:
+  template <typename Material>
+  MaterialPointArena(const Material& material, std::size_t n)
+      : storage_(allocate(n)),
+        dead_(n, 0) {
+    MaterialPoint* points = storage_.get();
+    try {
+      for (; size_ < n; ++size_)
+        ::new (static_cast<void*>(points + size_)) MaterialPoint(material);
+    } catch (...) {
+      destroy();
+      throw;
+    }
+  }
+
+  ~MaterialPointArena() { destroy(); }
+
+  MaterialPointArena(const MaterialPointArena&)            = delete;
+  MaterialPointArena& operator=(const MaterialPointArena&) = delete;
+
+  std::size_t size() const { return size_; }
+
+  MaterialPoint& operator[](std::size_t i) { return storage_.get()[i]; }
+  const MaterialPoint& operator[](std::size_t i) const { return storage_.get()[i]; }
+
+  // Replaces point i by a copy of source, constructed in place. The copy is made first, so if it throws the point is
+  // left untouched; only a throwing move of the copy into the slot leaves it dead. Points are replaced from parallel
+  // sweeps, so every slot has its own byte of dead_ and nothing is reallocated here.
+  void replace(std::size_t i, const MaterialPoint& source) {
+    MaterialPoint copy(source);
+    MaterialPoint* point = storage_.get() + i;
+    if (!dead_[i])
+      point->~MaterialPoint();
+    try {
+      ::new (static_cast<void*>(point)) MaterialPoint(std::move(copy));
+    } catch (...) {
+      dead_[i] = 1;
+      throw;
+    }
+    dead_[i] = 0;
+  }
+
+  MaterialPoint* begin() { return storage_.get(); }
+  MaterialPoint* end() { return storage_.get() + size_; }
+
+private:
+  struct Deallocate
+  {
+    void operator()(MaterialPoint* p) const {
+      ::operator delete(static_cast<void*>(p), std::align_val_t{alignof(MaterialPoint)});
+    }
+  };
+
+  static MaterialPoint* allocate(std::size_t n) {
+    if (n == 0)
+      return nullptr;
+    return static_cast<MaterialPoint*>(
+        ::operator new(n * sizeof(MaterialPoint), std::align_val_t{alignof(MaterialPoint)}));
+  }
+
+  void destroy() {
+    while (size_ > 0)
+      if (!dead_[--size_])
+        storage_.get()[size_].~MaterialPoint();
+  }
+
+  std::unique_ptr<MaterialPoint, Deallocate> storage_;
+  std::size_t size_ = 0;
+  std::vector<unsigned char> dead_; // slots whose replace() failed, one byte each
+};
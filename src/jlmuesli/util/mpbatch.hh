@@ -0,0 +1,620 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <jlmuesli/util/checkpoint.hh>
+#include <jlmuesli/util/convergedstate.hh>
+#include <jlmuesli/util/elementkernel.hh>
+#include <jlmuesli/util/layout.hh>
+#include <jlmuesli/util/mparena.hh>
+#include <jlmuesli/util/plasticpredictor.hh>
+#include <jlmuesli/util/pointstatus.hh>
+#include <jlmuesli/util/responsecache.hh>
+#include <jlmuesli/util/simdkernels.hh>
+#include <jlmuesli/util/statefield.hh>
+#include <jlmuesli/util/tangentsymmetry.hh>
+#include <jlmuesli/util/threadpool.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <muesli/muesli.h>
+
+// Substepping of the last update or evaluate sweep: points updated in substeps, their substeps in total, the largest
+// number of substeps of a single point and the points that no substep level recovered
+struct SubstepStatistics
+{
+  std::uint64_t points;
+  std::uint64_t substeps;
+  std::uint64_t maxSubsteps;
+  std::uint64_t unrecovered;
+};
+
+// Owns a set of material points of one type that all share the same material. This is the common part of the
+// small-strain and finite-strain batches, the strain measure specific evaluation lives in the derived classes.
+// The points are allocated contiguously from a MaterialPointArena, so a whole mesh needs a single allocation and a
+// single Julia finalizer.
+//
+// All sweeps over the points run on ThreadPool::global(). The material is only read and every point is touched by
+// exactly one thread, so the results are identical to a serial sweep.
+template <typename Material, typename MaterialPoint>
+class MPBatch
+{
+public:
+  using MaterialType      = Material;
+  using MaterialPointType = MaterialPoint;
+
+  MPBatch(const Material& material, std::size_t n)
+      : material_(material),
+        points_(material, n),
+        kernel_(BatchKernel<MaterialPoint>::parameters(material)),
+        kernelEnabled_(kernel_.has_value()) {}
+
+  std::size_t size() const { return points_.size(); }
+
+  const Material& material() const { return material_; }
+
+  MaterialPoint& operator[](std::size_t i) { return points_[i]; }
+  const MaterialPoint& operator[](std::size_t i) const { return points_[i]; }
+
+  void storedEnergy(double* energy) const {
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      ResponseCache::Counter counter(cache_);
+      for (std::size_t i = begin; i < end; ++i)
+        energy[i] = cache_.energy(i, counter, [&] { return points_[i].storedEnergy(); });
+    });
+  }
+
+  void commitCurrentState() {
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+        points_[i].commitCurrentState();
+      if (substepping()) {
+        std::copy(lastInput_.begin() + 9 * begin, lastInput_.begin() + 9 * end, startInput_.begin() + 9 * begin);
+        std::copy(lastTime_.begin() + begin, lastTime_.begin() + end, startTime_.begin() + begin);
+        for (std::size_t i = begin; i < end; ++i)
+          backups_[i].reset();
+      }
+    });
+    gatherPredictorState();
+  }
+
+  // Substepped points are restored from their copy of the converged step, see configureSubstepping
+  void resetCurrentState() {
+    cache_.invalidate();
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        if (substepping() && backups_[i]) {
+          points_.replace(i, *backups_[i]);
+          backups_[i].reset();
+        } else
+          points_[i].resetCurrentState();
+      }
+      if (substepping()) {
+        std::copy(startInput_.begin() + 9 * begin, startInput_.begin() + 9 * end, lastInput_.begin() + 9 * begin);
+        std::copy(startTime_.begin() + begin, startTime_.begin() + end, lastTime_.begin() + begin);
+      }
+    });
+    std::fill(status_.begin(), status_.end(), PS_CONVERGED);
+  }
+
+  // Memoization of stress, tangent and energy between updates, see ResponseCache. Updates, resets and restoring the
+  // converged state invalidate the cache. Points changed through operator[] are not tracked, call invalidateCache()
+  // after doing so.
+  void setCaching(bool enabled) {
+    if (enabled && !cache_.enabled())
+      cache_.enable(size());
+    else if (!enabled)
+      cache_.disable();
+  }
+
+  bool caching() const { return cache_.enabled(); }
+  void invalidateCache() { cache_.invalidate(); }
+  std::uint64_t cacheHits() const { return cache_.hits(); }
+  std::uint64_t cacheMisses() const { return cache_.misses(); }
+  void resetCacheCounters() { cache_.resetCounters(); }
+
+  // Whether the evaluate sweep uses the vectorized kernel of simdkernels.hh. It is enabled by default for the point
+  // types that have one, provided the kernel reproduced muesli for this material.
+  bool simdKernel() const { return kernelEnabled_; }
+
+  void setSimdKernel(bool enabled) {
+    if (enabled && !kernel_)
+      throw std::logic_error("There is no verified vectorized kernel for this material point type.");
+    kernelEnabled_ = enabled;
+  }
+
+  // Bucketed evaluate sweeps for the plasticity models, see plasticpredictor.hh. Before each sweep the points are
+  // split by an elastic predictor, the points predicted elastic are evaluated first and the predicted plastic ones
+  // afterwards as a dense worklist, so the return mappings are spread evenly over the threads. The results do not
+  // depend on the prediction. bucketStatistics() keeps the splits of the last bucketStatisticsCapacity sweeps, oldest
+  // first.
+  void setBucketing(bool enabled) {
+    if constexpr (!PlasticPredictor<MaterialPoint>::available) {
+      if (enabled)
+        throw std::logic_error("Bucketing is only supported for the plasticity models.");
+    } else if (enabled && !bucketing_) {
+      plasticity_ = plasticityParameters(material_);
+      predictor_.resize(size());
+      slip_.resize(size());
+      plastic_.resize(size());
+      worklist_.resize(size());
+      bucketing_ = true;
+      gatherPredictorState();
+    } else if (!enabled) {
+      bucketing_ = false;
+      predictor_ = {};
+      std::vector<double>().swap(slip_);
+      std::vector<unsigned char>().swap(plastic_);
+      std::vector<std::size_t>().swap(worklist_);
+    }
+  }
+
+  bool bucketing() const { return bucketing_; }
+  static constexpr std::size_t bucketStatisticsCapacity = 1024;
+
+  const std::deque<BucketStatistics>& bucketStatistics() const { return statistics_; }
+  void resetBucketStatistics() { statistics_.clear(); }
+
+  // Per-point status of the last update or evaluate sweep, see pointstatus.hh. With tracking enabled, the failure of
+  // a single point is recorded in status() and the sweep carries on with the other points, without tracking
+  // exceptions propagate.
+  void setStatusTracking(bool enabled) {
+    tracking_ = enabled;
+    if (enabled)
+      status_.assign(size(), PS_CONVERGED);
+    else
+      std::vector<unsigned char>().swap(status_);
+  }
+
+  bool statusTracking() const { return tracking_; }
+  const std::vector<unsigned char>& status() const { return status_; }
+  StatusSummary statusSummary() const { return summarizeStatus(status_.data(), status_.size()); }
+
+  // Local substepping for the points of the plasticity and damage models that fail, see configureSubstepping. Only
+  // those points pay for the extra updates.
+  bool substepping() const { return maxSubsteps_ > 0; }
+
+  // Substeps of the last update per point, 1 for a plain update and 0 if no substep level recovered the point
+  const std::vector<std::uint32_t>& substeps() const { return substeps_; }
+
+  SubstepStatistics substepStatistics() const {
+    SubstepStatistics statistics{0, 0, 0, 0};
+    for (const std::uint32_t m : substeps_) {
+      statistics.points += m > 1;
+      statistics.substeps += m > 1 ? m : 0;
+      statistics.maxSubsteps = std::max<std::uint64_t>(statistics.maxSubsteps, m);
+      statistics.unrecovered += m == 0;
+    }
+    return statistics;
+  }
+
+  // Writes the converged states of all points to a binary checkpoint, see checkpoint.hh. The states are gathered in
+  // parallel blocks and written sequentially.
+  void saveConvergedState(const std::string& path, const std::string& typeTag) const {
+    CheckpointWriter writer(path, typeTag, size());
+    std::vector<muesli::materialState> block;
+    for (std::size_t first = 0; first < size(); first += checkpointBlockSize) {
+      block.resize(std::min(checkpointBlockSize, size() - first));
+      ThreadPool::global().parallelFor(block.size(), batchGrainSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+          block[i] = points_[first + i].getConvergedState();
+      });
+      for (const auto& state : block)
+        writer.write(state);
+    }
+    writer.finish();
+  }
+
+  // Restores the converged states of all points from a checkpoint written by saveConvergedState for a batch with the
+  // same type tag and size
+  void restoreConvergedState(const std::string& path, const std::string& typeTag) {
+    if constexpr (!ConvergedStateTraits<MaterialPoint>::restorable)
+      throw std::logic_error("Restoring the converged state is not supported for " + typeTag + ".");
+    else {
+      const CheckpointReader reader(path);
+      if (reader.typeTag() != typeTag)
+        throw std::invalid_argument("Checkpoint holds " + reader.typeTag() + ", not " + typeTag + ".");
+      if (reader.size() != size())
+        throw std::invalid_argument("Checkpoint holds " + std::to_string(reader.size()) + " points, the batch has " +
+                                    std::to_string(size()) + ".");
+      cache_.invalidate();
+      forEachRange([&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+          ConvergedStateTraits<MaterialPoint>::restore(points_[i], reader.state(i));
+      });
+      gatherPredictorState();
+      gatherSubstepStart();
+    }
+  }
+
+  // Writes entry k of a history field of every point into out, stateFieldComponents(field) values per point
+  void exportState(StateField field, std::size_t k, bool converged, double* out) const {
+    const std::size_t components = stateFieldComponents(field);
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        const muesli::materialState state =
+            converged ? points_[i].getConvergedState() : points_[i].getCurrentState();
+        writeStateField(state, field, k, out + components * i);
+      }
+    });
+  }
+
+  // Overwrites entry k of a history field in the converged state of every point, the other fields are kept
+  void importConvergedState(StateField field, std::size_t k, const double* data) {
+    if constexpr (!ConvergedStateTraits<MaterialPoint>::restorable)
+      throw std::logic_error("Setting the converged state is not supported for this material point type.");
+    else {
+      cache_.invalidate();
+      const std::size_t components = stateFieldComponents(field);
+      forEachRange([&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          muesli::materialState state = points_[i].getConvergedState();
+          readStateField(state, field, k, data + components * i);
+          ConvergedStateTraits<MaterialPoint>::restore(points_[i], state);
+        }
+      });
+      gatherPredictorState();
+      gatherSubstepStart();
+    }
+  }
+
+  // Sets the converged state of every point with restore(point, i), e.g. from contiguous arrays of internal variables.
+  // Like importConvergedState, this invalidates the cache.
+  template <typename Restore>
+  void setConvergedState(Restore&& restore) {
+    cache_.invalidate();
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+        restore(points_[i], i);
+    });
+    gatherPredictorState();
+    gatherSubstepStart();
+  }
+
+protected:
+  static constexpr std::size_t checkpointBlockSize = 4096;
+
+  // Element stiffness matrices for elements made of consecutive points, see elementkernel.hh. Element e owns the
+  // points e * pointsPerElement, ..., (e + 1) * pointsPerElement - 1, dN holds the 3 x nodes gradients and weights the
+  // quadrature weight of every point, K receives one 3 nodes x 3 nodes matrix per element. tangent(i, counter, A)
+  // writes the 81 components of the tangent of point i to A.
+  template <typename Tangent>
+  void assembleElementStiffness(const double* dN, const double* weights, std::size_t nodes, std::size_t elements,
+                                double* K, Tangent&& tangent) const {
+    if (elements == 0 || size() % elements != 0)
+      throw std::invalid_argument("The points cannot be split evenly into " + std::to_string(elements) +
+                                  " elements.");
+    const std::size_t pointsPerElement = size() / elements;
+    const std::size_t blockSize        = 9 * nodes * nodes;
+    const std::size_t grainSize        = std::max<std::size_t>(1, batchGrainSize / pointsPerElement);
+
+    ThreadPool::global().parallelFor(elements, grainSize, [&](std::size_t begin, std::size_t end) {
+      ResponseCache::Counter counter(cache_);
+      std::vector<double> scratch;
+      double A[81];
+      for (std::size_t e = begin; e < end; ++e) {
+        double* Ke = K + blockSize * e;
+        std::fill(Ke, Ke + blockSize, 0.0);
+        for (std::size_t q = 0; q < pointsPerElement; ++q) {
+          const std::size_t i = e * pointsPerElement + q;
+          tangent(i, counter, A);
+          addStiffness(A, dN + 3 * nodes * i, nodes, weights[i], Ke, scratch);
+        }
+      }
+    });
+  }
+
+  static constexpr std::size_t plasticGrainSize = 8;
+
+  // Bucketed sweep, see setBucketing. classify(begin, end, plastic) flags the points predicted plastic, update(i)
+  // updates point i and respond(i, elastic) writes its response, elastic tells whether the update left the plastic
+  // slip unchanged.
+  template <typename Classify, typename Update, typename Respond>
+  void bucketedSweep(Classify&& classify, Update&& update, Respond&& respond) {
+    const std::size_t n = size();
+    forEachRange([&](std::size_t begin, std::size_t end) { classify(begin, end, plastic_.data()); });
+
+    std::size_t elastic = 0, plastic = n;
+    for (std::size_t i = 0; i < n; ++i)
+      worklist_[plastic_[i] ? --plastic : elastic++] = i;
+    std::reverse(worklist_.begin() + elastic, worklist_.end());
+
+    std::atomic<std::uint64_t> plasticCount{0}, mispredicted{0};
+    const auto sweep = [&](std::size_t first, std::size_t count, std::size_t grainSize) {
+      ThreadPool::global().parallelFor(count, grainSize, [&](std::size_t begin, std::size_t end) {
+        std::uint64_t yielded = 0, wrong = 0;
+        for (std::size_t k = first + begin; k < first + end; ++k) {
+          const std::size_t i = worklist_[k];
+          update(i);
+          const bool stayedElastic = !(points_[i].plasticSlip() > slip_[i]);
+          yielded += !stayedElastic;
+          wrong += stayedElastic == static_cast<bool>(plastic_[i]);
+          respond(i, stayedElastic);
+        }
+        plasticCount.fetch_add(yielded, std::memory_order_relaxed);
+        mispredicted.fetch_add(wrong, std::memory_order_relaxed);
+      });
+    };
+    sweep(0, elastic, batchGrainSize);
+    sweep(elastic, n - elastic, plasticGrainSize);
+
+    if (statistics_.size() == bucketStatisticsCapacity)
+      statistics_.pop_front();
+    statistics_.push_back({n, n - elastic, plasticCount.load(), mispredicted.load()});
+  }
+
+  // Updates point i with update(point). With status tracking, inputStatus() checks the input of the point first and
+  // the outcome is recorded, see guardedUpdate.
+  template <typename InputStatus, typename Update>
+  void updatePoint(std::size_t i, InputStatus&& inputStatus, Update&& update) {
+    if (!tracking_)
+      update(points_[i]);
+    else
+      status_[i] = guardedUpdate(points_[i], inputStatus(), update);
+  }
+
+  // Marks point i as failed if its response holds NaN or infinite values and resets it. Returns whether the point
+  // failed, in the update or here, so that its outputs have to be written again from its converged state.
+  bool checkResponse(std::size_t i, const double* values, std::size_t n) {
+    if (!tracking_)
+      return false;
+    if (status_[i] == PS_CONVERGED && !allFinite(values, n)) {
+      status_[i] = PS_NON_FINITE;
+      resetPoint(i);
+    }
+    return pointFailed(status_[i]);
+  }
+
+  static constexpr std::size_t maxSubstepLevels = 16;
+
+  // Enables substepping with up to 2^maxLevels substeps per point, 0 disables it. A point whose update throws, or
+  // whose response in an evaluate sweep is not finite, is updated again from its converged state in 2, 4, ...,
+  // 2^maxLevels equal substeps of time and input, committing all but the last substep. Before the first substep the
+  // point is copied, resetCurrentState() restores the copy and commitCurrentState() drops it. With incrementLimit > 0
+  // the plasticity models also split increments larger than incrementLimit yield strains (yield / 2 mu) right away.
+  // The converged input is read from the converged state where ConvergedStateTraits knows its layout, for the other
+  // models it is tracked from the updates, starting at reference (9 column-major components) when enabled.
+  void configureSubstepping(std::size_t maxLevels, double incrementLimit, const double* reference) {
+    static_assert(std::is_copy_constructible_v<MaterialPoint>, "Substepping needs copyable material points.");
+    if (maxLevels > maxSubstepLevels)
+      throw std::invalid_argument("Substepping supports at most " + std::to_string(maxSubstepLevels) + " levels.");
+    if (!(incrementLimit >= 0.0))
+      throw std::invalid_argument("The increment limit must not be negative.");
+    if (maxLevels == 0) {
+      maxSubsteps_ = 0;
+      std::vector<double>().swap(startInput_);
+      std::vector<double>().swap(lastInput_);
+      std::vector<double>().swap(startTime_);
+      std::vector<double>().swap(lastTime_);
+      std::vector<std::unique_ptr<MaterialPoint>>().swap(backups_);
+      std::vector<std::uint32_t>().swap(substeps_);
+      return;
+    }
+    if (incrementLimit > 0.0) {
+      if constexpr (!PlasticPredictor<MaterialPoint>::available)
+        throw std::logic_error("The increment limit is only supported for the plasticity models.");
+      else {
+        const PlasticityParameters parameters = plasticityParameters(material_);
+        yieldStrain_                          = parameters.yield / (2.0 * parameters.mu);
+      }
+    }
+    const bool enabling = !substepping();
+    incrementLimit_     = incrementLimit;
+    maxSubsteps_        = std::size_t(1) << maxLevels;
+    if (enabling) {
+      startInput_.resize(9 * size());
+      for (std::size_t i = 0; i < size(); ++i)
+        std::copy(reference, reference + 9, startInput_.begin() + 9 * i);
+      startTime_.resize(size());
+      backups_.resize(size());
+      substeps_.assign(size(), 1);
+      gatherSubstepStart();
+    }
+  }
+
+  // Updates point i to the input x (9 column-major components) at time t with substepping. update(mp, t, x) updates
+  // a point, failed(mp) tells whether the response of a substep is unusable. With status tracking a failed
+  // inputStatus skips the update and the outcome is recorded, without tracking a point that cannot be recovered is
+  // updated once more in a single step, so the failure surfaces as without substepping.
+  template <typename Update, typename Failed>
+  void substepPoint(std::size_t i, double t, const double* x, PointStatus inputStatus, Update&& update,
+                    Failed&& failed) {
+    std::copy(x, x + 9, lastInput_.begin() + 9 * i);
+    lastTime_[i] = t;
+    substeps_[i] = 1;
+    if (backups_[i])
+      resetPoint(i);
+    if (tracking_ && inputStatus != PS_CONVERGED) {
+      status_[i] = inputStatus;
+      resetPoint(i);
+      return;
+    }
+    const std::size_t first = estimatedSubsteps(i);
+    if (first == 1) {
+      try {
+        update(points_[i], t, x);
+        finishSubsteps(i, PS_CONVERGED, update);
+        return;
+      } catch (...) {
+      }
+    }
+    finishSubsteps(i, recoverPoint(i, first == 1 ? 2 : first, update, failed), update);
+  }
+
+  // Updates point i again in substeps if the response S of its plain update is not finite. Returns whether the point
+  // changed, its response has to be evaluated again then.
+  template <typename Update, typename Failed>
+  bool recoverResponse(std::size_t i, const istensor& S, Update&& update, Failed&& failed) {
+    double values[9];
+    writeColumnMajor(S, values);
+    if (substeps_[i] != 1 || (tracking_ && pointFailed(status_[i])) || allFinite(values, 9) ||
+        !allFinite(lastInput_.data() + 9 * i, 9))
+      return false;
+    finishSubsteps(i, recoverPoint(i, 2, update, failed), update);
+    return true;
+  }
+
+  // Calls f(begin, end) on disjoint ranges of points, possibly in parallel
+  template <typename F>
+  void forEachRange(F&& f) const {
+    ThreadPool::global().parallelFor(size(), batchGrainSize, std::forward<F>(f));
+  }
+
+  // Runs the vectorized kernel on the points [begin, end), input and output hold the values of all points
+  void evaluateKernel(std::size_t begin, std::size_t end, const double* input, std::size_t inputComponents,
+                      double* stress, std::size_t components, double* C, TangentLayout layout, double* energy) const {
+    const std::size_t stride = tangentComponents(layout);
+    BatchKernel<MaterialPoint>::evaluate(*kernel_, end - begin, input + inputComponents * begin, components,
+                                         stress + components * begin, C + stride * begin, layout, energy + begin);
+  }
+
+  const Material& material_;
+  MaterialPointArena<MaterialPoint> points_;
+  ResponseCache cache_;
+  std::optional<typename BatchKernel<MaterialPoint>::Parameters> kernel_;
+  bool kernelEnabled_;
+
+  // Bucketing, the predictor holds the converged internal variables and slip_ the converged plastic slip
+  bool bucketing_ = false;
+  PlasticityParameters plasticity_{};
+  typename PlasticPredictor<MaterialPoint>::Predictor predictor_;
+  std::vector<double> slip_;
+  std::vector<unsigned char> plastic_;
+  std::vector<std::size_t> worklist_;
+  std::deque<BucketStatistics> statistics_;
+
+  bool tracking_ = false;
+  std::vector<unsigned char> status_;
+
+  // Substepping, converged and last input and time of every point, copies of the converged step of the points that
+  // were substepped since the last commit and the substeps of the last update
+  std::size_t maxSubsteps_ = 0;
+  double incrementLimit_   = 0.0;
+  double yieldStrain_      = 0.0;
+  std::vector<double> startInput_;
+  std::vector<double> lastInput_;
+  std::vector<double> startTime_;
+  std::vector<double> lastTime_;
+  std::vector<std::unique_ptr<MaterialPoint>> backups_;
+  std::vector<std::uint32_t> substeps_;
+
+private:
+  // Substeps needed to keep the increment of point i below the increment limit
+  std::size_t estimatedSubsteps(std::size_t i) const {
+    if (incrementLimit_ <= 0.0)
+      return 1;
+    double norm = 0.0;
+    for (std::size_t a = 9 * i; a < 9 * i + 9; ++a)
+      norm += (lastInput_[a] - startInput_[a]) * (lastInput_[a] - startInput_[a]);
+    const double m = std::ceil(std::sqrt(norm) / (incrementLimit_ * yieldStrain_));
+    return m > 1.0 ? static_cast<std::size_t>(std::min(m, static_cast<double>(maxSubsteps_))) : 1;
+  }
+
+  // Resets point i to its converged step
+  void resetPoint(std::size_t i) {
+    if (substepping() && backups_[i]) {
+      points_.replace(i, *backups_[i]);
+      backups_[i].reset();
+    } else
+      points_[i].resetCurrentState();
+  }
+
+  // Updates point i from its converged step in m, 2 m, ... substeps until one level succeeds, returns the outcome of
+  // the last level
+  template <typename Update, typename Failed>
+  PointStatus recoverPoint(std::size_t i, std::size_t m, Update& update, Failed& failed) {
+    if (!backups_[i]) {
+      points_[i].resetCurrentState();
+      backups_[i] = std::make_unique<MaterialPoint>(points_[i]);
+    }
+    PointStatus result = PS_FAILED;
+    for (; m <= maxSubsteps_; m *= 2) {
+      points_.replace(i, *backups_[i]);
+      result = runSubsteps(i, m, update, failed);
+      if (result == PS_CONVERGED) {
+        substeps_[i] = static_cast<std::uint32_t>(m);
+        return result;
+      }
+    }
+    substeps_[i] = 0;
+    return result;
+  }
+
+  template <typename Update, typename Failed>
+  PointStatus runSubsteps(std::size_t i, std::size_t m, Update& update, Failed& failed) {
+    const double* x0 = startInput_.data() + 9 * i;
+    const double* x1 = lastInput_.data() + 9 * i;
+    const double t0 = startTime_[i], t1 = lastTime_[i];
+    double x[9];
+    try {
+      for (std::size_t k = 1; k <= m; ++k) {
+        const double theta = static_cast<double>(k) / static_cast<double>(m);
+        for (std::size_t a = 0; a < 9; ++a)
+          x[a] = x0[a] + theta * (x1[a] - x0[a]);
+        update(points_[i], k == m ? t1 : t0 + theta * (t1 - t0), k == m ? x1 : x);
+        if (failed(points_[i]))
+          return PS_NON_FINITE;
+        if (k < m)
+          points_[i].commitCurrentState();
+      }
+    } catch (...) {
+      return PS_FAILED;
+    }
+    return PS_CONVERGED;
+  }
+
+  // Records the outcome of updating point i. Without status tracking an unrecovered point is updated in a single
+  // step again, which rethrows or reproduces the unusable response.
+  template <typename Update>
+  void finishSubsteps(std::size_t i, PointStatus result, Update& update) {
+    if (result != PS_CONVERGED)
+      resetPoint(i);
+    if (tracking_)
+      status_[i] = result == PS_CONVERGED && fullyDamaged(points_[i]) ? PS_FULLY_DAMAGED : result;
+    else if (result != PS_CONVERGED)
+      update(points_[i], lastTime_[i], lastInput_.data() + 9 * i);
+  }
+
+  // Converged time and input of every point, see configureSubstepping
+  void gatherSubstepStart() {
+    if (!substepping())
+      return;
+    forEachRange([&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        backups_[i].reset();
+        const muesli::materialState state = points_[i].getConvergedState();
+        startTime_[i]                     = state.theTime;
+        if constexpr (ConvergedStateTraits<MaterialPoint>::restorable)
+          ConvergedStateTraits<MaterialPoint>::input(state, startInput_.data() + 9 * i);
+      }
+    });
+    lastInput_ = startInput_;
+    lastTime_  = startTime_;
+  }
+
+  void gatherPredictorState() {
+    if constexpr (PlasticPredictor<MaterialPoint>::available) {
+      if (!bucketing_)
+        return;
+      forEachRange([&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          PlasticPredictor<MaterialPoint>::gather(points_[i].getConvergedState(), predictor_, i);
+          slip_[i] = points_[i].plasticSlip();
+        }
+      });
+    }
+  }
+};
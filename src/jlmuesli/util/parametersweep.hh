@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <jlmuesli/util/evaluate.hh>
+#include <jlmuesli/util/pointdriver.hh>
+#include <jlmuesli/util/threadpool.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Parameter sweeps for calibration. A sweep holds a set of base material properties and the names of the swept
+// properties. For every candidate (one row of a candidates x parameters matrix) it builds the material from the base
+// properties with the swept values substituted, drives a fresh point through a shared load history (see
+// pointdriver.hh) and records the stress and energy of every step. Candidates run in parallel on
+// ThreadPool::global(), each one on its own material, so the results do not depend on the number of threads.
+//
+// Given reference stresses of the same layout as one response curve, the misfit of a candidate is the sum of squared
+// differences over all components and steps.
+//
+// Infeasible candidates are routine in a calibration, so a candidate whose material or history fails does not abort
+// the sweep. Its stress and energy are NaN, its misfit +Inf and its status that of the failed step, or PS_FAILED if
+// the material could not be built.
+template <typename Material>
+class ParameterSweep
+{
+public:
+  ParameterSweep(std::string name, std::multimap<std::string, double> properties)
+      : name_(std::move(name)),
+        properties_(std::move(properties)) {}
+
+  // Only properties that are set in the base properties can be swept, so a misspelled key is caught here and not
+  // silently ignored by the material
+  void addParameter(const std::string& key) {
+    if (properties_.find(key) == properties_.end())
+      throw std::invalid_argument("Property " + key + " is not set in the base properties of the sweep.");
+    if (std::find(keys_.begin(), keys_.end(), key) != keys_.end())
+      throw std::invalid_argument("Property " + key + " is swept already.");
+    keys_.push_back(key);
+  }
+  std::size_t parameters() const { return keys_.size(); }
+  const std::string& parameter(std::size_t j) const { return keys_.at(j); }
+
+  // Material of candidate c from the candidates x parameters matrix (column-major)
+  Material material(std::size_t candidates, const double* values, std::size_t c) const {
+    std::multimap<std::string, double> properties = properties_;
+    for (std::size_t j = 0; j < keys_.size(); ++j) {
+      properties.erase(keys_[j]);
+      properties.insert({keys_[j], values[c + candidates * j]});
+    }
+    return Material{name_, properties};
+  }
+
+  // Response curves of all candidates. drive(material, out) runs the history and returns the number of completed
+  // steps, see driveSmallStrainPoint and driveFiniteStrainPoint. stress receives components x steps and energy steps
+  // values per candidate. reference, misfit and status (one per candidate) may be null.
+  template <typename Drive>
+  void run(std::size_t candidates, const double* values, std::size_t steps, std::size_t components, double* stress,
+           double* energy, const double* reference, double* misfit, unsigned char* status, Drive&& drive) const {
+    ThreadPool::global().parallelFor(candidates, 1, [&](std::size_t begin, std::size_t end) {
+      std::vector<unsigned char> stepStatus(steps);
+      for (std::size_t c = begin; c < end; ++c) {
+        PointHistoryOutput out;
+        out.stressComponents = components;
+        out.stress           = stress + components * steps * c;
+        out.energy           = energy + steps * c;
+        out.status           = stepStatus.data();
+        PointStatus result   = PS_CONVERGED;
+        try {
+          const std::size_t completed = drive(material(candidates, values, c), out);
+          if (completed < steps)
+            result = static_cast<PointStatus>(stepStatus[completed]);
+        } catch (...) {
+          result = PS_FAILED;
+        }
+        if (status)
+          status[c] = result;
+        if (pointFailed(result)) {
+          std::fill(out.stress, out.stress + components * steps, std::numeric_limits<double>::quiet_NaN());
+          std::fill(out.energy, out.energy + steps, std::numeric_limits<double>::quiet_NaN());
+          if (misfit)
+            misfit[c] = std::numeric_limits<double>::infinity();
+          continue;
+        }
+        if (reference && misfit) {
+          double sum = 0.0;
+          for (std::size_t m = 0; m < components * steps; ++m)
+            sum += (out.stress[m] - reference[m]) * (out.stress[m] - reference[m]);
+          misfit[c] = sum;
+        }
+      }
+    });
+  }
+
+private:
+  std::string name_;
+  std::multimap<std::string, double> properties_;
+  std::vector<std::string> keys_;
+};
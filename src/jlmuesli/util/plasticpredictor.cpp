@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "plasticpredictor.hh"
+
+#include <cmath>
+
+namespace {
+constexpr std::size_t voigtPairs[6][2] = {
+    {0, 0},
+    {1, 1},
+    {2, 2},
+    {1, 2},
+    {0, 2},
+    {0, 1}
+};
+
+// Position of the symmetric pair (i, j) in the Voigt ordering
+constexpr std::size_t symmetricIndex[3][3] = {
+    {0, 5, 4},
+    {5, 1, 3},
+    {4, 3, 2}
+};
+
+// von Mises check of the trial stress 2 mu dev(d) against the surface around backStress, d in Voigt order with
+// tensorial shear components
+inline bool outsideYieldSurface(const PlasticityParameters& p, const double* d, const double* backStress,
+                                double hardening) {
+  const double mean = (d[0] + d[1] + d[2]) / 3.0;
+  double norm2      = 0.0;
+  for (std::size_t a = 0; a < 6; ++a) {
+    const double eta = 2.0 * p.mu * (d[a] - (a < 3 ? mean : 0.0)) - backStress[a];
+    norm2 += (a < 3 ? 1.0 : 2.0) * eta * eta;
+  }
+  const double radius = std::sqrt(2.0 / 3.0) * (p.yield + p.isotropicHardening * hardening);
+  return norm2 > radius * radius;
+}
+
+template <typename MaterialPoint, typename Material>
+PlasticityParameters smallStrainParameters(const Material& material) {
+  MaterialPoint mp(material);
+  mp.updateCurrentState(0.0, istensor(0.0, 0.0, 0.0, 0.0, 0.0, 0.0));
+  itensor4 C;
+  mp.tangentTensor(C);
+  return {C(0, 0, 1, 1), C(0, 1, 0, 1), material.getProperty(muesli::PR_YIELD),
+          material.getProperty(muesli::PR_ISOHARD), material.getProperty(muesli::PR_KINHARD)};
+}
+} // namespace
+
+void SmallStrainPlasticPredictor::resize(std::size_t n) {
+  n_ = n;
+  data_.assign(13 * n, 0.0);
+}
+
+void SmallStrainPlasticPredictor::store(std::size_t i, const istensor& plasticStrain, double hardening,
+                                        const istensor& backStrain) {
+  for (std::size_t a = 0; a < 6; ++a) {
+    data_[a * n_ + i]       = plasticStrain(voigtPairs[a][0], voigtPairs[a][1]);
+    data_[(7 + a) * n_ + i] = backStrain(voigtPairs[a][0], voigtPairs[a][1]);
+  }
+  data_[6 * n_ + i] = hardening;
+}
+
+void SmallStrainPlasticPredictor::classify(const PlasticityParameters& p, std::size_t begin, std::size_t end,
+                                           const double* strain, std::size_t components,
+                                           unsigned char* plastic) const {
+  const double* ep = data_.data();
+  const double* xi = data_.data() + 6 * n_;
+  const double* X  = data_.data() + 7 * n_;
+  for (std::size_t i = begin; i < end; ++i) {
+    const double* in = strain + components * i;
+    double d[6], backStress[6];
+    if (components == 6) {
+      for (std::size_t a = 0; a < 6; ++a)
+        d[a] = a < 3 ? in[a] : 0.5 * in[a];
+    } else {
+      for (std::size_t a = 0; a < 6; ++a)
+        d[a] = in[voigtPairs[a][0] + 3 * voigtPairs[a][1]];
+    }
+    for (std::size_t a = 0; a < 6; ++a) {
+      d[a] -= ep[a * n_ + i];
+      backStress[a] = p.kinematicHardening * X[a * n_ + i];
+    }
+    plastic[i] = outsideYieldSurface(p, d, backStress, xi[i]);
+  }
+}
+
+void FiniteStrainPlasticPredictor::resize(std::size_t n) {
+  n_ = n;
+  data_.assign(16 * n, 0.0);
+  // Identity F_n and be_n until the first converged state is stored
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t k : {0, 4, 8, 9, 10, 11})
+      data_[k * n + i] = 1.0;
+}
+
+void FiniteStrainPlasticPredictor::store(std::size_t i, const itensor& F, double hardening, const istensor& be) {
+  const itensor Finv = F.inverse();
+  for (std::size_t j = 0; j < 3; ++j)
+    for (std::size_t k = 0; k < 3; ++k)
+      data_[(k + 3 * j) * n_ + i] = Finv(k, j);
+  for (std::size_t a = 0; a < 6; ++a)
+    data_[(9 + a) * n_ + i] = be(voigtPairs[a][0], voigtPairs[a][1]);
+  data_[15 * n_ + i] = hardening;
+}
+
+void FiniteStrainPlasticPredictor::classify(const PlasticityParameters& p, std::size_t begin, std::size_t end,
+                                            const double* F, unsigned char* plastic) const {
+  const double* Finv = data_.data();
+  const double* be   = data_.data() + 9 * n_;
+  const double* xi   = data_.data() + 15 * n_;
+  for (std::size_t i = begin; i < end; ++i) {
+    const double* Fi = F + 9 * i;
+    double f[9]; // f = F F_n^-1, column-major
+    for (std::size_t j = 0; j < 3; ++j)
+      for (std::size_t r = 0; r < 3; ++r)
+        f[r + 3 * j] = Fi[r] * Finv[(3 * j) * n_ + i] + Fi[r + 3] * Finv[(1 + 3 * j) * n_ + i] +
+                       Fi[r + 6] * Finv[(2 + 3 * j) * n_ + i];
+
+    double d[6];
+    const double zero[6] = {};
+    for (std::size_t a = 0; a < 6; ++a) {
+      const std::size_t r = voigtPairs[a][0], s = voigtPairs[a][1];
+      double trial        = 0.0;
+      for (std::size_t k = 0; k < 3; ++k)
+        for (std::size_t l = 0; l < 3; ++l)
+          trial += f[r + 3 * k] * be[symmetricIndex[k][l] * n_ + i] * f[s + 3 * l];
+      d[a] = 0.5 * (trial - (a < 3 ? 1.0 : 0.0));
+    }
+    plastic[i] = outsideYieldSurface(p, d, zero, xi[i]);
+  }
+}
+
+PlasticityParameters plasticityParameters(const muesli::splasticMaterial& material) {
+  return smallStrainParameters<muesli::splasticMP>(material);
+}
+
+PlasticityParameters plasticityParameters(const muesli::viscoplasticMaterial& material) {
+  return smallStrainParameters<muesli::viscoplasticMP>(material);
+}
+
+PlasticityParameters plasticityParameters(const muesli::fplasticMaterial& material) {
+  muesli::fplasticMP mp(material);
+  mp.updateCurrentState(0.0, itensor(1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0));
+  itensor4 C;
+  mp.convectedTangent(C);
+  return {C(0, 0, 1, 1), C(0, 1, 0, 1), material.getProperty(muesli::PR_YIELD),
+          material.getProperty(muesli::PR_ISOHARD), 0.0};
+}
@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <muesli/Finitestrain/fplastic.h>
+#include <muesli/muesli.h>
+
+// Elastic predictors for the plasticity models. Before a bucketed evaluate sweep (see MPBatch::setBucketing) the
+// trial stress of every point is checked against the yield surface of its converged state, so that points predicted
+// to stay elastic and points predicted to yield can be evaluated in separate sweeps.
+//
+// The predictors only decide the order in which points are evaluated, every point is still updated by muesli. They
+// use a von Mises surface with linear isotropic and kinematic hardening built from the material properties, for
+// other yield criteria the prediction is merely less accurate. The converged internal variables are kept in
+// structure-of-arrays form, so the check is a plain arithmetic loop over the points.
+
+struct PlasticityParameters
+{
+  double lambda;
+  double mu;
+  double yield;
+  double isotropicHardening;
+  double kinematicHardening;
+};
+
+// Elastic split of one evaluate sweep. mispredicted counts the points that did not end up in their predicted bucket.
+struct BucketStatistics
+{
+  std::uint64_t points           = 0;
+  std::uint64_t predictedPlastic = 0;
+  std::uint64_t plastic          = 0;
+  std::uint64_t mispredicted     = 0;
+};
+
+// Trial stress lambda tr(e - ep) I + 2 mu (e - ep) against the converged surface with back stress H_kin X
+class SmallStrainPlasticPredictor
+{
+public:
+  void resize(std::size_t n);
+
+  void store(std::size_t i, const istensor& plasticStrain, double hardening, const istensor& backStrain);
+
+  // Flags the points in [begin, end) whose trial state lies outside the yield surface, strains are 6 Voigt or 9
+  // column-major components per point
+  void classify(const PlasticityParameters& p, std::size_t begin, std::size_t end, const double* strain,
+                std::size_t components, unsigned char* plastic) const;
+
+private:
+  std::size_t n_ = 0;
+  std::vector<double> data_; // 13 blocks of n_: plastic strain (Voigt), hardening variable, back strain (Voigt)
+};
+
+// Trial elastic left Cauchy-Green tensor be = f be_n f^T with f = F F_n^-1. The Kirchhoff stress is evaluated with the
+// linearized elastic strain (be - I) / 2, which is accurate for the small elastic strains of metal plasticity.
+class FiniteStrainPlasticPredictor
+{
+public:
+  void resize(std::size_t n);
+
+  void store(std::size_t i, const itensor& F, double hardening, const istensor& be);
+
+  // Flags the points in [begin, end) whose trial state lies outside the yield surface, F is column-major
+  void classify(const PlasticityParameters& p, std::size_t begin, std::size_t end, const double* F,
+                unsigned char* plastic) const;
+
+private:
+  std::size_t n_ = 0;
+  std::vector<double> data_; // 16 blocks of n_: inverse of F_n (column-major), be_n (Voigt), hardening variable
+};
+
+// Predictor of a material point type, the converged state is read in the layout of ConvergedStateTraits.
+// constantElasticTangent tells whether the tangent of a step that stays elastic is the same for every state and time
+// step, so the points predicted elastic can share the tangent of a virgin point.
+template <typename MaterialPoint>
+struct PlasticPredictor
+{
+  static constexpr bool available              = false;
+  static constexpr bool constantElasticTangent = false;
+  struct Predictor
+  {
+    void resize(std::size_t) {}
+  };
+
+  static void gather(const muesli::materialState&, Predictor&, std::size_t) {}
+};
+
+template <>
+struct PlasticPredictor<muesli::splasticMP>
+{
+  static constexpr bool available              = true;
+  static constexpr bool constantElasticTangent = true;
+  using Predictor                              = SmallStrainPlasticPredictor;
+
+  // (strain, dg, epn, xin, Xin)
+  static void gather(const muesli::materialState& state, Predictor& predictor, std::size_t i) {
+    predictor.store(i, state.theStensor[1], state.theDouble[1], state.theStensor[2]);
+  }
+};
+
+// The viscous regularization makes the tangent depend on the time step
+template <>
+struct PlasticPredictor<muesli::viscoplasticMP>
+{
+  static constexpr bool available              = true;
+  static constexpr bool constantElasticTangent = false;
+  using Predictor                              = SmallStrainPlasticPredictor;
+
+  // (dg, epn, xin, Xin, strain)
+  static void gather(const muesli::materialState& state, Predictor& predictor, std::size_t i) {
+    predictor.store(i, state.theStensor[0], state.theDouble[1], state.theStensor[1]);
+  }
+};
+
+template <>
+struct PlasticPredictor<muesli::fplasticMP>
+{
+  static constexpr bool available              = true;
+  static constexpr bool constantElasticTangent = false;
+  using Predictor                              = FiniteStrainPlasticPredictor;
+
+  // (F, iso, kine, be)
+  static void gather(const muesli::materialState& state, Predictor& predictor, std::size_t i) {
+    predictor.store(i, state.theTensor[0], state.theDouble[0], state.theStensor[0]);
+  }
+};
+
+// Lamé parameters from the elastic tangent of a virgin point, yield stress and hardening moduli from the material
+// properties
+PlasticityParameters plasticityParameters(const muesli::splasticMaterial& material);
+PlasticityParameters plasticityParameters(const muesli::viscoplasticMaterial& material);
+PlasticityParameters plasticityParameters(const muesli::fplasticMaterial& material);
@@ -0,0 +1,359 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <jlmuesli/util/evaluate.hh>
+#include <jlmuesli/util/layout.hh>
+#include <jlmuesli/util/pointstatus.hh>
+#include <jlmuesli/util/statefield.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <muesli/muesli.h>
+
+// Strain driven load histories of a single material point, run natively from start to end. A history of m steps
+// prescribes the strain (small strain) or deformation gradient (finite strain) at times[s]. A fresh point is updated
+// to every step in turn and committed afterwards, so the point sees the same sequence of calls as from a driving
+// loop in Julia.
+//
+// Outputs are written per step: the stress (small strain) or second Piola-Kirchhoff stress (finite strain) as 6 Voigt
+// or 9 column-major components, the stored energy and any number of history variables of the current state, see
+// statefield.hh. Only the outputs selected by flags (EVAL_STRESS, EVAL_ENERGY) are written.
+//
+// With a status output the drivers do not throw when the point fails. The status of every step is recorded (see
+// pointstatus.hh) and the history stops at the first failed step, the drivers return the number of completed steps.
+
+// History variable recorded by the drivers, entry k of a state field
+struct StateSelector
+{
+  StateField field;
+  std::size_t k;
+};
+
+// Values per step recorded for the selectors
+inline std::size_t selectedStateComponents(const std::vector<StateSelector>& selectors) {
+  std::size_t components = 0;
+  for (const auto& selector : selectors)
+    components += stateFieldComponents(selector.field);
+  return components;
+}
+
+struct PointHistoryOutput
+{
+  unsigned flags               = EVAL_STRESS | EVAL_ENERGY;
+  std::size_t stressComponents = 6;
+  double* stress               = nullptr; // stressComponents x steps
+  double* energy               = nullptr; // steps
+  std::vector<StateSelector> selectors;
+  double* state         = nullptr; // selectedStateComponents(selectors) x steps
+  unsigned char* status = nullptr; // steps, optional
+};
+
+// Writes the selected history variables of the current state of a point to values
+template <typename MaterialPoint>
+void recordState(const MaterialPoint& mp, const std::vector<StateSelector>& selectors, double* values) {
+  if (selectors.empty())
+    return;
+  const muesli::materialState state = mp.getCurrentState();
+  for (const auto& selector : selectors) {
+    writeStateField(state, selector.field, selector.k, values);
+    values += stateFieldComponents(selector.field);
+  }
+}
+
+// Writes the outputs of step s for a point that was just updated, stress(S) evaluates the stress
+template <typename MaterialPoint, typename Stress>
+void recordStep(const MaterialPoint& mp, std::size_t s, const PointHistoryOutput& out, Stress&& stress) {
+  if (out.flags & EVAL_STRESS) {
+    istensor S;
+    stress(S);
+    writeStressComponents(S, out.stress + out.stressComponents * s, out.stressComponents);
+  }
+  if (out.flags & EVAL_ENERGY)
+    out.energy[s] = mp.storedEnergy();
+  recordState(mp, out.selectors, out.state + selectedStateComponents(out.selectors) * s);
+}
+
+// Updates the point of step s with update(mp). With a status output the outcome is recorded, returns false if the
+// step failed.
+template <typename MaterialPoint, typename InputStatus, typename Update>
+bool updateStep(MaterialPoint& mp, std::size_t s, unsigned char* status, InputStatus&& inputStatus, Update&& update) {
+  if (!status) {
+    update(mp);
+    return true;
+  }
+  status[s] = guardedUpdate(mp, inputStatus(), update);
+  return !pointFailed(status[s]);
+}
+
+// Whether the stress recorded for step s is finite, marks the step otherwise
+inline bool checkRecordedStress(std::size_t s, const PointHistoryOutput& out) {
+  if (!out.status || !(out.flags & EVAL_STRESS) ||
+      allFinite(out.stress + out.stressComponents * s, out.stressComponents))
+    return true;
+  out.status[s] = PS_NON_FINITE;
+  return false;
+}
+
+// Records step s after updateStep, returns whether the step succeeded. A failed step, in the update or with a stress
+// that is not finite, is recorded from the reset point, i.e. with the response of the last converged step.
+template <typename MaterialPoint, typename Stress>
+bool recordCheckedStep(MaterialPoint& mp, std::size_t s, const PointHistoryOutput& out, bool updated,
+                       Stress&& stress) {
+  recordStep(mp, s, out, stress);
+  if (!updated)
+    return false;
+  if (checkRecordedStress(s, out))
+    return true;
+  mp.resetCurrentState();
+  recordStep(mp, s, out, stress);
+  return false;
+}
+
+// Strain history with strainComponents (6 Voigt with engineering shear, or 9 column-major) values per step
+template <typename MaterialPoint, typename Material>
+std::size_t driveSmallStrainPoint(const Material& material, std::size_t steps, const double* times,
+                                  const double* strain, std::size_t strainComponents, const PointHistoryOutput& out) {
+  MaterialPoint mp(material);
+  for (std::size_t s = 0; s < steps; ++s) {
+    const double* e = strain + strainComponents * s;
+    const bool updated = updateStep(
+        mp, s, out.status, [&] { return strainStatus(e, strainComponents); },
+        [&](MaterialPoint& p) { p.updateCurrentState(times[s], strainFromComponents(e, strainComponents)); });
+    if (!recordCheckedStep(mp, s, out, updated, [&](istensor& S) { mp.stress(S); }))
+      return s;
+    mp.commitCurrentState();
+  }
+  return steps;
+}
+
+// History of column-major deformation gradients
+template <typename MaterialPoint, typename Material>
+std::size_t driveFiniteStrainPoint(const Material& material, std::size_t steps, const double* times, const double* F,
+                                   const PointHistoryOutput& out) {
+  MaterialPoint mp(material);
+  for (std::size_t s = 0; s < steps; ++s) {
+    const double* Fs = F + 9 * s;
+    const bool updated = updateStep(
+        mp, s, out.status, [&] { return deformationStatus(Fs); },
+        [&](MaterialPoint& p) { p.updateCurrentState(times[s], itensorFromColumnMajor(Fs)); });
+    if (!recordCheckedStep(mp, s, out, updated, [&](istensor& S) { mp.secondPiolaKirchhoffStress(S); }))
+      return s;
+    mp.commitCurrentState();
+  }
+  return steps;
+}
+
+// Mixed stress/strain control. Every step prescribes all components of the kinematic variable x, 6 Voigt strains
+// (engineering shear) in small strain or the 9 column-major components of F in finite strain. Components flagged in
+// control are stress controlled instead: their value prescribes the conjugate stress component (Voigt stress, or
+// first Piola-Kirchhoff stress P) and the corresponding component of x is found by a Newton iteration with the
+// tangent of the material point (Voigt tangent, or dP/dF). The iteration starts from x of the previous step.
+//
+// A step has converged once the largest residual of the controlled stresses is at most tolerance. The history stops
+// at the first step that does not converge within maxIterations, the point is committed after every converged step.
+// A non-finite prescribed value, iterate or stress (PS_NON_FINITE) or an iterate F with det F <= 0
+// (PS_NEGATIVE_JACOBIAN) stops the step as well. With a status output, a step that does not converge is marked with
+// its PointStatus and exceptions of the point are recorded as PS_FAILED instead of being thrown. Unlike the strain
+// driven histories, a step that does not converge records the last Newton iterate, which shows where the iteration
+// got stuck. A step that threw is recorded from the reset point, with x of the previous step and a NaN residual.
+
+struct NewtonOptions
+{
+  double tolerance          = 1.0e-8;
+  std::size_t maxIterations = 25;
+};
+
+struct MixedHistoryOutput
+{
+  double* strain = nullptr; // x of every step, 6 or 9 x steps
+  double* stress = nullptr; // conjugate stress of every step, 6 or 9 x steps
+  double* energy = nullptr; // steps, optional
+  std::vector<StateSelector> selectors;
+  double* state            = nullptr; // selectedStateComponents(selectors) x steps
+  std::int64_t* iterations = nullptr; // Newton iterations of every step
+  double* residual         = nullptr; // final residual of every step
+  unsigned char* status    = nullptr; // steps, optional
+};
+
+// Solves the m x m system A x = b (column-major, leading dimension lda) in place by Gaussian elimination with
+// partial pivoting, returns false if A is singular
+inline bool solveDense(std::size_t m, double* A, std::size_t lda, double* b) {
+  for (std::size_t c = 0; c < m; ++c) {
+    std::size_t pivot = c;
+    for (std::size_t r = c + 1; r < m; ++r)
+      if (std::abs(A[r + lda * c]) > std::abs(A[pivot + lda * c]))
+        pivot = r;
+    if (A[pivot + lda * c] == 0.0)
+      return false;
+    if (pivot != c) {
+      for (std::size_t k = c; k < m; ++k)
+        std::swap(A[c + lda * k], A[pivot + lda * k]);
+      std::swap(b[c], b[pivot]);
+    }
+    for (std::size_t r = c + 1; r < m; ++r) {
+      const double factor = A[r + lda * c] / A[c + lda * c];
+      for (std::size_t k = c + 1; k < m; ++k)
+        A[r + lda * k] -= factor * A[c + lda * k];
+      b[r] -= factor * b[c];
+    }
+  }
+  for (std::size_t c = m; c-- > 0;) {
+    for (std::size_t k = c + 1; k < m; ++k)
+      b[c] -= A[c + lda * k] * b[k];
+    b[c] /= A[c + lda * c];
+  }
+  return true;
+}
+
+// Newton iteration of one mixed controlled step on N components. x holds the start values and receives the solution,
+// inputStatus(x) checks an iterate before evaluate(x, stress, tangent) updates the point and returns the stress and
+// its derivative (N x N, column-major) with respect to x. Returns PS_CONVERGED, PS_ITERATIONS_EXCEEDED or the
+// status of a non-finite or invalid iterate or stress. A non-finite residual is reported as NaN.
+template <std::size_t N, typename InputStatus, typename Evaluate>
+PointStatus mixedControlStep(const unsigned char* control, const double* prescribed, const NewtonOptions& options,
+                             double* x, double* stress, std::int64_t& iterations, double& residual,
+                             InputStatus&& inputStatus, Evaluate&& evaluate) {
+  iterations = 0;
+  residual   = std::numeric_limits<double>::quiet_NaN();
+  if (!allFinite(prescribed, N))
+    return PS_NON_FINITE;
+  std::size_t unknowns[N], m = 0;
+  for (std::size_t a = 0; a < N; ++a) {
+    if (control[a])
+      unknowns[m++] = a;
+    else
+      x[a] = prescribed[a];
+  }
+
+  double tangent[N * N], A[N * N], r[N];
+  for (std::size_t iteration = 0;; ++iteration) {
+    iterations               = static_cast<std::int64_t>(iteration);
+    const PointStatus status = inputStatus(x);
+    if (status != PS_CONVERGED)
+      return status;
+    evaluate(x, stress, tangent);
+    if (!allFinite(stress, N)) {
+      residual = std::numeric_limits<double>::quiet_NaN();
+      return PS_NON_FINITE;
+    }
+    // Written so that a NaN residual propagates instead of being dropped by std::max
+    residual = 0.0;
+    for (std::size_t u = 0; u < m; ++u) {
+      r[u] = prescribed[unknowns[u]] - stress[unknowns[u]];
+      if (!(std::abs(r[u]) <= residual))
+        residual = std::abs(r[u]);
+    }
+    if (residual <= options.tolerance)
+      return PS_CONVERGED;
+    if (iteration == options.maxIterations)
+      return PS_ITERATIONS_EXCEEDED;
+
+    for (std::size_t v = 0; v < m; ++v)
+      for (std::size_t u = 0; u < m; ++u)
+        A[u + N * v] = tangent[unknowns[u] + N * unknowns[v]];
+    if (!solveDense(m, A, N, r))
+      return PS_ITERATIONS_EXCEEDED;
+    for (std::size_t u = 0; u < m; ++u)
+      x[unknowns[u]] += r[u];
+  }
+}
+
+// Runs a mixed controlled history on a fresh point, returns the number of converged steps. inputStatus(x) checks an
+// iterate, update(mp, t, x) updates the point, response(mp, stress, tangent) evaluates the conjugate stress and
+// tangent.
+template <std::size_t N, typename MaterialPoint, typename InputStatus, typename Update, typename Response>
+std::size_t driveMixedControl(MaterialPoint& mp, std::size_t steps, const double* times, const unsigned char* control,
+                              const double* prescribed, const NewtonOptions& options, const MixedHistoryOutput& out,
+                              double* x, InputStatus&& inputStatus, Update&& update, Response&& response) {
+  const std::size_t stateComponents = selectedStateComponents(out.selectors);
+  const auto record                 = [&](std::size_t s) {
+    std::copy(x, x + N, out.strain + N * s);
+    if (out.energy)
+      out.energy[s] = mp.storedEnergy();
+    recordState(mp, out.selectors, out.state + stateComponents * s);
+  };
+  for (std::size_t s = 0; s < steps; ++s) {
+    double* stress  = out.stress + N * s;
+    double start[N];
+    std::copy(x, x + N, start);
+    const auto step = [&] {
+      return mixedControlStep<N>(control, prescribed + N * s, options, x, stress, out.iterations[s], out.residual[s],
+                                 inputStatus, [&](const double* xi, double* S, double* C) {
+                                   update(mp, times[s], xi);
+                                   response(mp, S, C);
+                                 });
+    };
+    PointStatus result = PS_FAILED;
+    if (!out.status)
+      result = step();
+    else {
+      try {
+        result = step();
+      } catch (...) {
+        // Record the step from the reset point, i.e. x and the response of the previous converged step
+        out.status[s]   = PS_FAILED;
+        out.residual[s] = std::numeric_limits<double>::quiet_NaN();
+        mp.resetCurrentState();
+        std::copy(start, start + N, x);
+        double tangent[N * N];
+        response(mp, stress, tangent);
+        record(s);
+        return s;
+      }
+      out.status[s] = result == PS_CONVERGED && fullyDamaged(mp) ? PS_FULLY_DAMAGED : result;
+    }
+    record(s);
+    if (result != PS_CONVERGED)
+      return s;
+    mp.commitCurrentState();
+  }
+  return steps;
+}
+
+// Small strain: x are 6 Voigt strains (engineering shear), the stress and tangent are Voigt
+template <typename MaterialPoint, typename Material>
+std::size_t driveSmallStrainMixed(const Material& material, std::size_t steps, const double* times,
+                                  const unsigned char* control, const double* prescribed,
+                                  const NewtonOptions& options, const MixedHistoryOutput& out) {
+  MaterialPoint mp(material);
+  double x[6] = {};
+  return driveMixedControl<6>(
+      mp, steps, times, control, prescribed, options, out, x, [](const double* e) { return strainStatus(e, 6); },
+      [](MaterialPoint& p, double t, const double* e) { p.updateCurrentState(t, strainFromVoigt(e)); },
+      [](const MaterialPoint& p, double* S, double* C) {
+        istensor sigma;
+        itensor4 T;
+        p.stress(sigma);
+        p.tangentTensor(T);
+        writeStressVoigt(sigma, S);
+        writeVoigt(T, C);
+      });
+}
+
+// Finite strain: x is F and the stress P, both column-major, the tangent dP/dF
+template <typename MaterialPoint, typename Material>
+std::size_t driveFiniteStrainMixed(const Material& material, std::size_t steps, const double* times,
+                                   const unsigned char* control, const double* prescribed,
+                                   const NewtonOptions& options, const MixedHistoryOutput& out) {
+  MaterialPoint mp(material);
+  double x[9] = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+  return driveMixedControl<9>(
+      mp, steps, times, control, prescribed, options, out, x, &deformationStatus,
+      [](MaterialPoint& p, double t, const double* F) { p.updateCurrentState(t, itensorFromColumnMajor(F)); },
+      [](const MaterialPoint& p, double* P, double* A) {
+        itensor stress;
+        itensor4 T;
+        p.firstPiolaKirchhoffStress(stress);
+        p.materialTangent(T);
+        writeColumnMajor(stress, P);
+        writeColumnMajor(T, A);
+      });
+}
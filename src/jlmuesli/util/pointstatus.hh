@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Outcome of updating a single material point, one byte per point or step. Batches with status tracking and the
+// drivers of pointdriver.hh record it instead of letting a failing point abort the whole sweep with an exception. A
+// point that failed (anything but PS_CONVERGED and PS_FULLY_DAMAGED) is reset to its converged state and its outputs
+// (stress, tangent, energy) are written from that state, also where a NaN response was detected only after writing
+// them. The caller can cut the step without restoring anything. The mixed controlled driver is the exception, it
+// records the last Newton iterate of a step that does not converge, only a step that threw is recorded from the
+// reset point.
+enum PointStatus : unsigned char
+{
+  PS_CONVERGED,           // updated normally
+  PS_ITERATIONS_EXCEEDED, // a local iteration did not converge within its iteration limit
+  PS_NEGATIVE_JACOBIAN,   // det F <= 0, the point was not updated
+  PS_FULLY_DAMAGED,       // updated, but the material has lost all stiffness
+  PS_NON_FINITE,          // NaN or infinite input or response
+  PS_FAILED               // the material point threw an exception
+};
+
+constexpr std::size_t pointStatusCount = 6;
+
+inline bool pointFailed(unsigned char status) { return status != PS_CONVERGED && status != PS_FULLY_DAMAGED; }
+
+// Number of points per status code
+struct StatusSummary
+{
+  std::array<std::uint64_t, pointStatusCount> counts{};
+
+  std::uint64_t failures() const {
+    std::uint64_t sum = 0;
+    for (std::size_t code = 0; code < pointStatusCount; ++code)
+      sum += pointFailed(static_cast<unsigned char>(code)) ? counts[code] : 0;
+    return sum;
+  }
+};
+
+inline StatusSummary summarizeStatus(const unsigned char* status, std::size_t n) {
+  StatusSummary summary;
+  for (std::size_t i = 0; i < n; ++i)
+    ++summary.counts[status[i] < pointStatusCount ? status[i] : static_cast<unsigned char>(PS_FAILED)];
+  return summary;
+}
+
+inline bool allFinite(const double* values, std::size_t n) {
+  for (std::size_t a = 0; a < n; ++a)
+    if (!std::isfinite(values[a]))
+      return false;
+  return true;
+}
+
+// Status of a strain input before the update
+inline PointStatus strainStatus(const double* strain, std::size_t components) {
+  return allFinite(strain, components) ? PS_CONVERGED : PS_NON_FINITE;
+}
+
+// Status of a column-major deformation gradient before the update
+inline PointStatus deformationStatus(const double* F) {
+  if (!allFinite(F, 9))
+    return PS_NON_FINITE;
+  const double J = F[0] * (F[4] * F[8] - F[7] * F[5]) - F[3] * (F[1] * F[8] - F[7] * F[2]) +
+                   F[6] * (F[1] * F[5] - F[4] * F[2]);
+  return J > 0.0 ? PS_CONVERGED : PS_NEGATIVE_JACOBIAN;
+}
+
+// Damage models (finite strain points and the sdamage family) report a fully damaged state
+template <typename MaterialPoint, typename = void>
+struct HasDamage : std::false_type
+{};
+
+template <typename MaterialPoint>
+struct HasDamage<MaterialPoint, std::void_t<decltype(std::declval<const MaterialPoint&>().isFullyDamaged())>>
+    : std::true_type
+{};
+
+template <typename MaterialPoint>
+bool fullyDamaged(const MaterialPoint& mp) {
+  if constexpr (HasDamage<MaterialPoint>::value)
+    return mp.isFullyDamaged();
+  else
+    return false;
+}
+
+// Updates a point with update(mp) unless the input status already failed. Exceptions are caught, failed points are
+// reset to their converged state.
+template <typename MaterialPoint, typename Update>
+PointStatus guardedUpdate(MaterialPoint& mp, PointStatus inputStatus, Update&& update) {
+  if (inputStatus == PS_CONVERGED) {
+    try {
+      update(mp);
+      return fullyDamaged(mp) ? PS_FULLY_DAMAGED : PS_CONVERGED;
+    } catch (...) {
+      inputStatus = PS_FAILED;
+    }
+  }
+  mp.resetCurrentState();
+  return inputStatus;
+}
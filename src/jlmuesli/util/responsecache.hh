@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <jlmuesli/util/evaluate.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <muesli/Math/mtensor.h>
+
+// Memoized stress, tangent and energy of the points of a batch. An entry is computed on the first request after an
+// update and served from the cache until invalidate() is called. Points are only ever touched by one thread at a
+// time, the hit and miss counts are collected per thread in a Counter and added once per range.
+//
+// When the cache is disabled every lookup calls compute directly and nothing is counted.
+class ResponseCache
+{
+public:
+  class Counter
+  {
+  public:
+    explicit Counter(const ResponseCache& cache)
+        : cache_(cache) {}
+
+    ~Counter() {
+      if (hits_ > 0)
+        cache_.hits_.fetch_add(hits_, std::memory_order_relaxed);
+      if (misses_ > 0)
+        cache_.misses_.fetch_add(misses_, std::memory_order_relaxed);
+    }
+
+    Counter(const Counter&)            = delete;
+    Counter& operator=(const Counter&) = delete;
+
+  private:
+    friend class ResponseCache;
+
+    const ResponseCache& cache_;
+    std::uint64_t hits_   = 0;
+    std::uint64_t misses_ = 0;
+  };
+
+  bool enabled() const { return enabled_; }
+
+  void enable(std::size_t n) {
+    stress_.resize(n);
+    tangent_.resize(n);
+    energy_.resize(n);
+    valid_.assign(n, 0);
+    enabled_ = true;
+  }
+
+  void disable() {
+    enabled_ = false;
+    std::vector<istensor>().swap(stress_);
+    std::vector<itensor4>().swap(tangent_);
+    std::vector<double>().swap(energy_);
+    std::vector<unsigned char>().swap(valid_);
+  }
+
+  void invalidate() { std::fill(valid_.begin(), valid_.end(), 0); }
+
+  // compute(T&) evaluates the response of point i into its argument
+  template <typename Compute>
+  const istensor& stress(std::size_t i, istensor& scratch, Counter& counter, Compute&& compute) const {
+    return lookup(i, EVAL_STRESS, stress_, scratch, counter, compute);
+  }
+
+  template <typename Compute>
+  const itensor4& tangent(std::size_t i, itensor4& scratch, Counter& counter, Compute&& compute) const {
+    return lookup(i, EVAL_TANGENT, tangent_, scratch, counter, compute);
+  }
+
+  template <typename Compute>
+  double energy(std::size_t i, Counter& counter, Compute&& compute) const {
+    double scratch = 0.0;
+    return lookup(i, EVAL_ENERGY, energy_, scratch, counter, [&](double& e) { e = compute(); });
+  }
+
+  // Stores a complete response, used by the fused evaluate sweeps
+  void store(std::size_t i, const istensor& S, const itensor4& C, double energy) const {
+    if (!enabled_)
+      return;
+    stress_[i]  = S;
+    tangent_[i] = C;
+    energy_[i]  = energy;
+    valid_[i]   = EVAL_ALL;
+  }
+
+  std::uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+  std::uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+
+  void resetCounters() {
+    hits_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  template <typename T, typename Compute>
+  const T& lookup(std::size_t i, unsigned flag, std::vector<T>& entries, T& scratch, Counter& counter,
+                  Compute&& compute) const {
+    if (!enabled_) {
+      compute(scratch);
+      return scratch;
+    }
+    if (valid_[i] & flag) {
+      ++counter.hits_;
+      return entries[i];
+    }
+    compute(entries[i]);
+    valid_[i] |= flag;
+    ++counter.misses_;
+    return entries[i];
+  }
+
+  bool enabled_ = false;
+  mutable std::vector<istensor> stress_;
+  mutable std::vector<itensor4> tangent_;
+  mutable std::vector<double> energy_;
+  mutable std::vector<unsigned char> valid_;
+  mutable std::atomic<std::uint64_t> hits_{0};
+  mutable std::atomic<std::uint64_t> misses_{0};
+};
@@ -0,0 +1,344 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "simdkernels.hh"
+
+#include <algorithm>
+#include <cmath>
+
+// One clone per instruction set, the dynamic loader resolves the call to the best one the CPU supports
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__linux__)
+  #define JLMUESLI_SIMD_DISPATCH
+  #define JLMUESLI_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+  #define JLMUESLI_TARGET_CLONES
+#endif
+
+namespace {
+// Points per block, a multiple of the vector width of every instruction set
+constexpr std::size_t lanes = 8;
+
+// Position of the symmetric pair (i, j) in the Voigt ordering of layout.hh
+constexpr std::size_t symmetricIndex[3][3] = {
+    {0, 5, 4},
+    {5, 1, 3},
+    {4, 3, 2}
+};
+
+// Position of the Voigt entry (a, b) in the packed upper triangle
+constexpr std::size_t packedIndex(std::size_t a, std::size_t b) {
+  return a <= b ? 6 * a - a * (a - 1) / 2 + (b - a) : packedIndex(b, a);
+}
+
+// Maps every entry of the Voigt and of the full layout to the packed entry holding it
+struct TangentIndex
+{
+  std::size_t voigt[36];
+  std::size_t full[81];
+};
+
+constexpr TangentIndex makeTangentIndex() {
+  TangentIndex index{};
+  for (std::size_t b = 0; b < 6; ++b)
+    for (std::size_t a = 0; a < 6; ++a)
+      index.voigt[a + 6 * b] = packedIndex(a, b);
+  for (std::size_t l = 0; l < 3; ++l)
+    for (std::size_t k = 0; k < 3; ++k)
+      for (std::size_t j = 0; j < 3; ++j)
+        for (std::size_t i = 0; i < 3; ++i)
+          index.full[i + 3 * j + 9 * k + 27 * l] = packedIndex(symmetricIndex[i][j], symmetricIndex[k][l]);
+  return index;
+}
+
+constexpr TangentIndex tangentIndex = makeTangentIndex();
+
+// Writes lane l of a packed tangent held in structure-of-arrays form
+inline void writeTangentLane(const double (*c)[lanes], std::size_t l, double* out, TangentLayout layout) {
+  switch (layout) {
+    case TangentLayout::Full:
+      for (std::size_t m = 0; m < 81; ++m)
+        out[m] = c[tangentIndex.full[m]][l];
+      break;
+    case TangentLayout::Voigt:
+      for (std::size_t m = 0; m < 36; ++m)
+        out[m] = c[tangentIndex.voigt[m]][l];
+      break;
+    case TangentLayout::Packed:
+      for (std::size_t m = 0; m < 21; ++m)
+        out[m] = c[m][l];
+      break;
+  }
+}
+
+// Writes lane l of a symmetric tensor held in structure-of-arrays Voigt form
+inline void writeStressLane(const double (*s)[lanes], std::size_t l, double* out, std::size_t components) {
+  if (components == 6) {
+    for (std::size_t a = 0; a < 6; ++a)
+      out[a] = s[a][l];
+  } else {
+    for (std::size_t j = 0; j < 3; ++j)
+      for (std::size_t i = 0; i < 3; ++i)
+        out[i + 3 * j] = s[symmetricIndex[i][j]][l];
+  }
+}
+
+// Constant tangent lambda I x I + 2 mu II of the linear isotropic law
+inline void isotropicTangent(const IsotropicParameters& p, double* out, TangentLayout layout) {
+  double c[21][lanes] = {};
+  for (std::size_t a = 0; a < 3; ++a) {
+    for (std::size_t b = a; b < 3; ++b)
+      c[packedIndex(a, b)][0] = a == b ? p.lambda + 2.0 * p.mu : p.lambda;
+    c[packedIndex(a + 3, a + 3)][0] = p.mu;
+  }
+  writeTangentLane(c, 0, out, layout);
+}
+
+// s = lambda tr(e) I + 2 mu e and w = s : e / 2 for a block, e in Voigt order with tensorial shear components
+inline void linearIsotropicBlock(const IsotropicParameters& p, const double (*e)[lanes], double (*s)[lanes],
+                                 double* w) {
+  for (std::size_t l = 0; l < lanes; ++l) {
+    const double volumetric = p.lambda * (e[0][l] + e[1][l] + e[2][l]);
+    for (std::size_t a = 0; a < 6; ++a)
+      s[a][l] = (a < 3 ? volumetric : 0.0) + 2.0 * p.mu * e[a][l];
+    w[l] = 0.5 * (s[0][l] * e[0][l] + s[1][l] * e[1][l] + s[2][l] * e[2][l]) + s[3][l] * e[3][l] +
+           s[4][l] * e[4][l] + s[5][l] * e[5][l];
+  }
+}
+
+// Largest deviation between the kernel and muesli, relative to the largest muesli value
+double deviation(const double* kernel, const double* reference, std::size_t n) {
+  double scale = 0.0, error = 0.0;
+  for (std::size_t m = 0; m < n; ++m) {
+    scale = std::max(scale, std::abs(reference[m]));
+    error = std::max(error, std::abs(kernel[m] - reference[m]));
+  }
+  return scale > 0.0 ? error / scale : error;
+}
+
+constexpr double agreementTolerance = 1.0e-10;
+
+bool agrees(const double* stress, const double* tangent, double energy, const double* referenceStress,
+            const double* referenceTangent, double referenceEnergy) {
+  return deviation(stress, referenceStress, 9) < agreementTolerance &&
+         deviation(tangent, referenceTangent, 81) < agreementTolerance &&
+         deviation(&energy, &referenceEnergy, 1) < agreementTolerance;
+}
+} // namespace
+
+const char* simdInstructionSet() {
+#ifdef JLMUESLI_SIMD_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return "avx512f";
+  if (__builtin_cpu_supports("avx2"))
+    return "avx2";
+#endif
+  return "scalar";
+}
+
+JLMUESLI_TARGET_CLONES
+void elasticIsotropicKernel(const IsotropicParameters& p, std::size_t n, const double* strain, std::size_t components,
+                            double* sigma, double* C, TangentLayout layout, double* energy) {
+  const std::size_t stride = tangentComponents(layout);
+  double tangent[81];
+  isotropicTangent(p, tangent, layout);
+
+  for (std::size_t first = 0; first < n; first += lanes) {
+    const std::size_t m = std::min(lanes, n - first);
+    double e[6][lanes]  = {};
+    double s[6][lanes];
+    double w[lanes];
+
+    for (std::size_t l = 0; l < m; ++l) {
+      const double* in = strain + components * (first + l);
+      if (components == 6) {
+        for (std::size_t a = 0; a < 6; ++a)
+          e[a][l] = a < 3 ? in[a] : 0.5 * in[a];
+      } else {
+        // Same components as istensorFromColumnMajor
+        e[0][l] = in[0];
+        e[1][l] = in[4];
+        e[2][l] = in[8];
+        e[3][l] = in[5];
+        e[4][l] = in[6];
+        e[5][l] = in[1];
+      }
+    }
+
+    linearIsotropicBlock(p, e, s, w);
+
+    for (std::size_t l = 0; l < m; ++l) {
+      const std::size_t i = first + l;
+      writeStressLane(s, l, sigma + components * i, components);
+      std::copy(tangent, tangent + stride, C + stride * i);
+      energy[i] = w[l];
+    }
+  }
+}
+
+JLMUESLI_TARGET_CLONES
+void svkKernel(const IsotropicParameters& p, std::size_t n, const double* F, std::size_t components, double* S,
+               double* C, TangentLayout layout, double* energy) {
+  const std::size_t stride = tangentComponents(layout);
+  double tangent[81];
+  isotropicTangent(p, tangent, layout);
+
+  for (std::size_t first = 0; first < n; first += lanes) {
+    const std::size_t m = std::min(lanes, n - first);
+    double f[9][lanes];
+    double e[6][lanes], s[6][lanes], w[lanes];
+
+    for (std::size_t k = 0; k < 9; ++k)
+      for (std::size_t l = 0; l < lanes; ++l)
+        f[k][l] = l < m ? F[9 * (first + l) + k] : (k % 4 == 0 ? 1.0 : 0.0);
+
+    // Green-Lagrange strain E = (F^T F - I) / 2 from the columns of F
+    for (std::size_t a = 0; a < 6; ++a) {
+      const std::size_t I = voigtIndex[a][0], J = voigtIndex[a][1];
+      for (std::size_t l = 0; l < lanes; ++l)
+        e[a][l] = 0.5 * (f[3 * I][l] * f[3 * J][l] + f[3 * I + 1][l] * f[3 * J + 1][l] +
+                         f[3 * I + 2][l] * f[3 * J + 2][l] - (a < 3 ? 1.0 : 0.0));
+    }
+
+    linearIsotropicBlock(p, e, s, w);
+
+    for (std::size_t l = 0; l < m; ++l) {
+      const std::size_t i = first + l;
+      writeStressLane(s, l, S + components * i, components);
+      std::copy(tangent, tangent + stride, C + stride * i);
+      energy[i] = w[l];
+    }
+  }
+}
+
+JLMUESLI_TARGET_CLONES
+void neohookeanKernel(const IsotropicParameters& p, std::size_t n, const double* F, std::size_t components, double* S,
+                      double* C, TangentLayout layout, double* energy) {
+  const std::size_t stride = tangentComponents(layout);
+
+  for (std::size_t first = 0; first < n; first += lanes) {
+    const std::size_t m = std::min(lanes, n - first);
+    double f[9][lanes];
+    double inv[6][lanes], trace[lanes], jacobian[lanes], logJ[lanes];
+    double s[6][lanes], c[21][lanes], w[lanes];
+
+    // Unused lanes hold the identity
+    for (std::size_t k = 0; k < 9; ++k)
+      for (std::size_t l = 0; l < lanes; ++l)
+        f[k][l] = l < m ? F[9 * (first + l) + k] : (k % 4 == 0 ? 1.0 : 0.0);
+
+    for (std::size_t l = 0; l < lanes; ++l) {
+      // Right Cauchy-Green tensor from the columns of F, in Voigt order
+      double r[6];
+      for (std::size_t a = 0; a < 6; ++a) {
+        const std::size_t I = voigtIndex[a][0], J = voigtIndex[a][1];
+        r[a] = f[3 * I][l] * f[3 * J][l] + f[3 * I + 1][l] * f[3 * J + 1][l] + f[3 * I + 2][l] * f[3 * J + 2][l];
+      }
+      const double det = f[0][l] * (f[4][l] * f[8][l] - f[7][l] * f[5][l]) -
+                         f[3][l] * (f[1][l] * f[8][l] - f[7][l] * f[2][l]) +
+                         f[6][l] * (f[1][l] * f[5][l] - f[4][l] * f[2][l]);
+      const double scale = 1.0 / (det * det);
+      inv[0][l]          = scale * (r[1] * r[2] - r[3] * r[3]);
+      inv[1][l]          = scale * (r[0] * r[2] - r[4] * r[4]);
+      inv[2][l]          = scale * (r[0] * r[1] - r[5] * r[5]);
+      inv[3][l]          = scale * (r[4] * r[5] - r[0] * r[3]);
+      inv[4][l]          = scale * (r[5] * r[3] - r[1] * r[4]);
+      inv[5][l]          = scale * (r[4] * r[3] - r[2] * r[5]);
+      trace[l]           = r[0] + r[1] + r[2];
+      jacobian[l]        = det;
+    }
+
+    // Kept apart so that the loops around it stay vectorizable
+    for (std::size_t l = 0; l < lanes; ++l)
+      logJ[l] = std::log(jacobian[l]);
+
+    for (std::size_t l = 0; l < lanes; ++l) {
+      const double pressure = p.lambda * logJ[l] - p.mu;
+      for (std::size_t a = 0; a < 6; ++a)
+        s[a][l] = (a < 3 ? p.mu : 0.0) + pressure * inv[a][l];
+      w[l] = 0.5 * p.mu * (trace[l] - 3.0) - p.mu * logJ[l] + 0.5 * p.lambda * logJ[l] * logJ[l];
+    }
+
+    for (std::size_t a = 0; a < 6; ++a)
+      for (std::size_t b = a; b < 6; ++b) {
+        const std::size_t I = voigtIndex[a][0], J = voigtIndex[a][1];
+        const std::size_t K = voigtIndex[b][0], L = voigtIndex[b][1];
+        const std::size_t IK = symmetricIndex[I][K], JL = symmetricIndex[J][L];
+        const std::size_t IL = symmetricIndex[I][L], JK = symmetricIndex[J][K];
+        double* entry = c[packedIndex(a, b)];
+        for (std::size_t l = 0; l < lanes; ++l)
+          entry[l] = p.lambda * inv[a][l] * inv[b][l] +
+                     (p.mu - p.lambda * logJ[l]) * (inv[IK][l] * inv[JL][l] + inv[IL][l] * inv[JK][l]);
+      }
+
+    for (std::size_t l = 0; l < m; ++l) {
+      const std::size_t i = first + l;
+      writeStressLane(s, l, S + components * i, components);
+      writeTangentLane(c, l, C + stride * i, layout);
+      energy[i] = w[l];
+    }
+  }
+}
+
+std::optional<IsotropicParameters> elasticIsotropicKernelParameters(const muesli::elasticIsotropicMaterial& material) {
+  muesli::elasticIsotropicMP mp(material);
+  itensor4 T;
+  mp.updateCurrentState(0.0, istensor(0.0, 0.0, 0.0, 0.0, 0.0, 0.0));
+  mp.tangentTensor(T);
+  const IsotropicParameters p{T(0, 0, 1, 1), T(0, 1, 0, 1)};
+
+  const istensor probe(1.0e-3, -2.0e-3, 5.0e-4, 3.0e-4, -1.0e-4, 7.0e-4);
+  mp.updateCurrentState(0.0, probe);
+  istensor sigma;
+  mp.stress(sigma);
+  mp.tangentTensor(T);
+  double strain[9], referenceStress[9], referenceTangent[81];
+  writeColumnMajor(probe, strain);
+  writeColumnMajor(sigma, referenceStress);
+  writeColumnMajor(T, referenceTangent);
+
+  double stress[9], tangent[81], energy = 0.0;
+  elasticIsotropicKernel(p, 1, strain, 9, stress, tangent, TangentLayout::Full, &energy);
+  if (!agrees(stress, tangent, energy, referenceStress, referenceTangent, mp.storedEnergy()))
+    return std::nullopt;
+  return p;
+}
+
+namespace {
+// Lame parameters from the convected tangent at F = I, verified against a probe point
+template <typename MaterialPoint, typename Material, typename Kernel>
+std::optional<IsotropicParameters> finiteStrainKernelParameters(const Material& material, Kernel&& kernel) {
+  MaterialPoint mp(material);
+  itensor4 T;
+  mp.updateCurrentState(0.0, itensor(1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0));
+  mp.convectedTangent(T);
+  const IsotropicParameters p{T(0, 0, 1, 1), T(0, 1, 0, 1)};
+
+  const itensor probe(1.10, 0.05, -0.02, // Row 1
+                      0.03, 0.95, 0.04,  // Row 2
+                      -0.01, 0.02, 1.05  // Row 3
+  );
+  mp.updateCurrentState(0.0, probe);
+  istensor S;
+  mp.secondPiolaKirchhoffStress(S);
+  mp.convectedTangent(T);
+  double F[9], referenceStress[9], referenceTangent[81];
+  writeColumnMajor(probe, F);
+  writeColumnMajor(S, referenceStress);
+  writeColumnMajor(T, referenceTangent);
+
+  double stress[9], tangent[81], energy = 0.0;
+  kernel(p, 1, F, 9, stress, tangent, TangentLayout::Full, &energy);
+  if (!agrees(stress, tangent, energy, referenceStress, referenceTangent, mp.storedEnergy()))
+    return std::nullopt;
+  return p;
+}
+} // namespace
+
+std::optional<IsotropicParameters> neohookeanKernelParameters(const muesli::neohookeanMaterial& material) {
+  return finiteStrainKernelParameters<muesli::neohookeanMP>(material, &neohookeanKernel);
+}
+
+std::optional<IsotropicParameters> svkKernelParameters(const muesli::svkMaterial& material) {
+  return finiteStrainKernelParameters<muesli::svkMP>(material, &svkKernel);
+}
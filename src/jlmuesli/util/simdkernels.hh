@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <jlmuesli/util/layout.hh>
+
+#include <cstddef>
+#include <optional>
+
+#include <muesli/muesli.h>
+
+// Closed-form batch kernels for the isotropic elastic (small strain), Neo-Hookean and Saint Venant-Kirchhoff (finite
+// strain) models. Points are processed in blocks of lanes in structure-of-arrays form so that the compiler vectorizes
+// across points. The kernels are compiled for AVX-512, AVX2 and baseline x86-64, the variant is picked at load time
+// from the CPU (on other platforms only the portable version is built).
+//
+// The Lamé parameters are read off the muesli tangent at the reference state. A kernel is only used after it
+// reproduced the muesli stress, tangent and energy of a probe point to round-off, otherwise the batches keep calling
+// muesli (see MPBatch::simdKernel).
+//
+// Inputs and outputs use the layouts of layout.hh: strains as 6 Voigt or 9 column-major components, deformation
+// gradients as 9 column-major components, stresses as 6 Voigt or 9 column-major components.
+
+struct IsotropicParameters
+{
+  double lambda;
+  double mu;
+};
+
+// Instruction set of the kernel variant selected at runtime: "avx512f", "avx2" or "scalar"
+const char* simdInstructionSet();
+
+// sigma = lambda tr(e) I + 2 mu e, the constant isotropic tangent and the energy 1/2 sigma : e of n points
+void elasticIsotropicKernel(const IsotropicParameters& p, std::size_t n, const double* strain, std::size_t components,
+                            double* sigma, double* C, TangentLayout layout, double* energy);
+
+// W = mu / 2 (tr C - 3) - mu ln J + lambda / 2 (ln J)^2 with its second Piola-Kirchhoff stress and convected tangent
+void neohookeanKernel(const IsotropicParameters& p, std::size_t n, const double* F, std::size_t components, double* S,
+                      double* C, TangentLayout layout, double* energy);
+
+// S = lambda tr(E) I + 2 mu E of the Green-Lagrange strain E, the constant convected tangent and the energy S : E / 2
+void svkKernel(const IsotropicParameters& p, std::size_t n, const double* F, std::size_t components, double* S,
+               double* C, TangentLayout layout, double* energy);
+
+// Parameters for the kernels, std::nullopt if the kernel does not agree with muesli for this material
+std::optional<IsotropicParameters> elasticIsotropicKernelParameters(const muesli::elasticIsotropicMaterial& material);
+std::optional<IsotropicParameters> neohookeanKernelParameters(const muesli::neohookeanMaterial& material);
+std::optional<IsotropicParameters> svkKernelParameters(const muesli::svkMaterial& material);
+
+// Batch kernel of a material point type, used by the evaluate sweeps of the batches when available
+template <typename MaterialPoint>
+struct BatchKernel
+{
+  static constexpr bool available = false;
+  using Parameters                = IsotropicParameters;
+
+  template <typename Material>
+  static std::optional<Parameters> parameters(const Material&) {
+    return std::nullopt;
+  }
+};
+
+template <>
+struct BatchKernel<muesli::elasticIsotropicMP>
+{
+  static constexpr bool available = true;
+  using Parameters                = IsotropicParameters;
+
+  static std::optional<Parameters> parameters(const muesli::elasticIsotropicMaterial& material) {
+    return elasticIsotropicKernelParameters(material);
+  }
+
+  static void evaluate(const Parameters& p, std::size_t n, const double* strain, std::size_t components,
+                       double* sigma, double* C, TangentLayout layout, double* energy) {
+    elasticIsotropicKernel(p, n, strain, components, sigma, C, layout, energy);
+  }
+};
+
+template <>
+struct BatchKernel<muesli::neohookeanMP>
+{
+  static constexpr bool available = true;
+  using Parameters                = IsotropicParameters;
+
+  static std::optional<Parameters> parameters(const muesli::neohookeanMaterial& material) {
+    return neohookeanKernelParameters(material);
+  }
+
+  static void evaluate(const Parameters& p, std::size_t n, const double* F, std::size_t components, double* S,
+                       double* C, TangentLayout layout, double* energy) {
+    neohookeanKernel(p, n, F, components, S, C, layout, energy);
+  }
+};
+
+template <>
+struct BatchKernel<muesli::svkMP>
+{
+  static constexpr bool available = true;
+  using Parameters                = IsotropicParameters;
+
+  static std::optional<Parameters> parameters(const muesli::svkMaterial& material) {
+    return svkKernelParameters(material);
+  }
+
+  static void evaluate(const Parameters& p, std::size_t n, const double* F, std::size_t components, double* S,
+                       double* C, TangentLayout layout, double* energy) {
+    svkKernel(p, n, F, components, S, C, layout, energy);
+  }
+};
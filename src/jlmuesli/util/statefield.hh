@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "layout.hh"
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <muesli/muesli.h>
+
+// Selects one of the containers of a muesli::materialState. A field together with an index k names a single history
+// variable, e.g. (SF_STENSOR, 1) is theStensor[1]. Per point a field holds
+//  - SF_DOUBLE:  1 value
+//  - SF_VECTOR:  3 values
+//  - SF_STENSOR: 6 values in Voigt order (11, 22, 33, 23, 13, 12), without engineering shear factors
+//  - SF_TENSOR:  9 values, column-major
+enum StateField
+{
+  SF_DOUBLE,
+  SF_VECTOR,
+  SF_STENSOR,
+  SF_TENSOR
+};
+
+inline std::size_t stateFieldComponents(StateField field) {
+  switch (field) {
+    case SF_DOUBLE:
+      return 1;
+    case SF_VECTOR:
+      return 3;
+    case SF_STENSOR:
+      return 6;
+    case SF_TENSOR:
+      return 9;
+  }
+  throw std::invalid_argument("Unknown state field.");
+}
+
+inline std::size_t stateFieldCount(const muesli::materialState& state, StateField field) {
+  switch (field) {
+    case SF_DOUBLE:
+      return state.theDouble.size();
+    case SF_VECTOR:
+      return state.theVector.size();
+    case SF_STENSOR:
+      return state.theStensor.size();
+    case SF_TENSOR:
+      return state.theTensor.size();
+  }
+  throw std::invalid_argument("Unknown state field.");
+}
+
+inline void assertStateFieldIndex(const muesli::materialState& state, StateField field, std::size_t k) {
+  if (k >= stateFieldCount(state, field))
+    throw std::out_of_range("Index out of range for the state field.");
+}
+
+// Writes entry k of the field to out (stateFieldComponents(field) values)
+inline void writeStateField(const muesli::materialState& state, StateField field, std::size_t k, double* out) {
+  assertStateFieldIndex(state, field, k);
+  switch (field) {
+    case SF_DOUBLE:
+      out[0] = state.theDouble[k];
+      break;
+    case SF_VECTOR:
+      for (std::size_t i = 0; i < 3; ++i)
+        out[i] = state.theVector[k](i);
+      break;
+    case SF_STENSOR:
+      writeStressVoigt(state.theStensor[k], out);
+      break;
+    case SF_TENSOR:
+      writeColumnMajor(state.theTensor[k], out);
+      break;
+  }
+}
+
+// Overwrites entry k of the field with the values in data, the inverse of writeStateField
+inline void readStateField(muesli::materialState& state, StateField field, std::size_t k, const double* data) {
+  assertStateFieldIndex(state, field, k);
+  switch (field) {
+    case SF_DOUBLE:
+      state.theDouble[k] = data[0];
+      break;
+    case SF_VECTOR:
+      for (std::size_t i = 0; i < 3; ++i)
+        state.theVector[k](i) = data[i];
+      break;
+    case SF_STENSOR:
+      state.theStensor[k] = istensor(data[0], data[1], data[2], data[3], data[4], data[5]);
+      break;
+    case SF_TENSOR:
+      state.theTensor[k] = itensorFromColumnMajor(data);
+      break;
+  }
+}
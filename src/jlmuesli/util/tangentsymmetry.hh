@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <jlmuesli/util/layout.hh>
+
+#include <stdexcept>
+#include <type_traits>
+
+#include <muesli/Finitestrain/fplastic.h>
+#include <muesli/Smallstrain/sdamage.h>
+#include <muesli/muesli.h>
+
+// Whether the tangents of a material point type have major symmetry, C_ijkl = C_klij, so the packed layout (the upper
+// triangle of the Voigt matrix) holds all of them. The damage models couple damage and strain non-symmetrically and
+// the convected tangent of fplastic loses major symmetry in some plastic states.
+template <typename MaterialPoint>
+struct MajorSymmetricTangent : std::true_type
+{};
+
+template <>
+struct MajorSymmetricTangent<muesli::GTN_MP> : std::false_type
+{};
+
+template <>
+struct MajorSymmetricTangent<muesli::Gurson_MP> : std::false_type
+{};
+
+template <>
+struct MajorSymmetricTangent<muesli::Lemaitre_MP> : std::false_type
+{};
+
+template <>
+struct MajorSymmetricTangent<muesli::LemKin_MP> : std::false_type
+{};
+
+template <>
+struct MajorSymmetricTangent<muesli::fplasticMP> : std::false_type
+{};
+
+// Rejects the packed layout for material points whose tangents may lack major symmetry
+template <typename MaterialPoint>
+void checkTangentLayout(TangentLayout layout) {
+  if (layout == TangentLayout::Packed && !MajorSymmetricTangent<MaterialPoint>::value)
+    throw std::logic_error("The tangent of this material point type has no major symmetry, the packed layout would "
+                           "drop its non-symmetric part. Use the Voigt or full layout.");
+}
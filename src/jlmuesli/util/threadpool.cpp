@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "threadpool.hh"
+
+#include <algorithm>
+#include <cstdlib>
+
+thread_local bool ThreadPool::insideLoop_ = false;
+
+ThreadPool::ThreadPool(std::size_t numThreads) { start(numThreads > 1 ? numThreads - 1 : 0); }
+
+ThreadPool::~ThreadPool() { stop(); }
+
+ThreadPool& ThreadPool::global() {
+  static ThreadPool pool([] {
+    if (const char* env = std::getenv("JLMUESLI_NUM_THREADS")) {
+      const long n = std::strtol(env, nullptr, 10);
+      if (n > 0)
+        return static_cast<std::size_t>(n);
+    }
+    return std::size_t{1};
+  }());
+  return pool;
+}
+
+void ThreadPool::resize(std::size_t numThreads) {
+  // 0 means one thread per hardware thread
+  if (numThreads == 0)
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  const std::lock_guard<std::mutex> running(runMutex_);
+  if (numThreads == size())
+    return;
+  stop();
+  start(numThreads - 1);
+}
+
+void ThreadPool::start(std::size_t numWorkers) {
+  shutdown_ = false;
+  workers_.reserve(numWorkers);
+  for (std::size_t i = 0; i < numWorkers; ++i)
+    workers_.emplace_back(&ThreadPool::workerLoop, this, i + 1, generation_);
+  numWorkers_.store(workers_.size(), std::memory_order_relaxed);
+}
+
+void ThreadPool::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  wakeUp_.notify_all();
+  numWorkers_.store(0, std::memory_order_relaxed);
+  for (auto& worker : workers_)
+    worker.join();
+  workers_.clear();
+}
+
+void ThreadPool::run(std::size_t n, std::size_t grain, std::function<void(std::size_t, std::size_t)> body) {
+  // There is a single job slot, a caller that finds it taken runs its loop on its own
+  std::unique_lock<std::mutex> running(runMutex_, std::try_to_lock);
+  if (!running.owns_lock()) {
+    body(0, n);
+    return;
+  }
+
+  auto job   = std::make_shared<Job>();
+  job->body  = std::move(body);
+  job->n     = n;
+  job->grain = grain;
+
+  // Initial distribution: every participant owns a contiguous block of chunks. workers_ is stable while runMutex_ is
+  // held, a pool that was resized to a single thread since parallelFor looked leaves the caller on its own.
+  const std::size_t chunks       = (n + grain - 1) / grain;
+  const std::size_t participants = workers_.size() + 1;
+  job->shares                    = std::vector<Share>(participants);
+  for (std::size_t p = 0; p < participants; ++p) {
+    job->shares[p].begin = chunks * p / participants;
+    job->shares[p].end   = chunks * (p + 1) / participants;
+  }
+  job->active = participants;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = job;
+    ++generation_;
+  }
+  wakeUp_.notify_all();
+
+  participate(*job, 0);
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_.wait(lock, [&] { return job->active == 0; });
+    job_.reset();
+  }
+
+  if (job->exception)
+    std::rethrow_exception(job->exception);
+}
+
+void ThreadPool::participate(Job& job, std::size_t self) {
+  insideLoop_ = true;
+  std::size_t chunk;
+  while (nextChunk(job, self, chunk)) {
+    // After a failure the remaining chunks are drained without evaluating them
+    if (job.failed)
+      continue;
+    const std::size_t begin = chunk * job.grain;
+    try {
+      job.body(begin, std::min(job.n, begin + job.grain));
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(job.exceptionMutex);
+      if (!job.exception)
+        job.exception = std::current_exception();
+      job.failed = true;
+    }
+  }
+  insideLoop_ = false;
+
+  if (job.active.fetch_sub(1) == 1) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_.notify_all();
+  }
+}
+
+bool ThreadPool::nextChunk(Job& job, std::size_t self, std::size_t& chunk) {
+  Share& own = job.shares[self];
+  {
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (own.begin < own.end) {
+      chunk = own.begin++;
+      return true;
+    }
+  }
+
+  // Own share is exhausted, steal the upper half of another participant's remaining chunks
+  const std::size_t participants = job.shares.size();
+  for (std::size_t k = 1; k < participants; ++k) {
+    Share& victim = job.shares[(self + k) % participants];
+    std::size_t begin, end;
+    {
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      const std::size_t remaining = victim.end - victim.begin;
+      if (remaining == 0)
+        continue;
+      end        = victim.end;
+      begin      = end - (remaining + 1) / 2;
+      victim.end = begin;
+    }
+    {
+      std::lock_guard<std::mutex> lock(own.mutex);
+      own.begin = begin + 1;
+      own.end   = end;
+    }
+    chunk = begin;
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::workerLoop(std::size_t self, std::size_t seenGeneration) {
+  for (;;) {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wakeUp_.wait(lock, [&] { return shutdown_ || generation_ != seenGeneration; });
+      if (shutdown_)
+        return;
+      seenGeneration = generation_;
+      job            = job_;
+    }
+    if (job)
+      participate(*job, self);
+  }
+}
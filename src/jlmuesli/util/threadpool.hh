@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker pool used by the batch engines. A parallel loop splits [0, n) into chunks of `grain` indices and hands each
+// participant (the workers plus the calling thread) a contiguous share of them. A participant that runs out of work
+// steals the upper half of the remaining chunks of another one, so expensive points (e.g. plastic ones) do not leave
+// threads idle.
+//
+// The loop body must only touch data belonging to its own index range. Since every index is evaluated by exactly one
+// thread with the same code as in serial execution, results do not depend on the number of threads.
+class ThreadPool
+{
+public:
+  // Total number of threads taking part in a loop, including the calling thread
+  explicit ThreadPool(std::size_t numThreads = 1);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&)            = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Pool shared by all batches. Its size is taken from JLMUESLI_NUM_THREADS and defaults to 1 (serial).
+  static ThreadPool& global();
+
+  std::size_t size() const { return numWorkers_.load(std::memory_order_relaxed) + 1; }
+
+  void resize(std::size_t numThreads);
+
+  // Calls f(begin, end) for disjoint ranges covering [0, n). Loops started from inside a loop body run serially, as
+  // do loops started from another thread while the pool is busy (e.g. Julia tasks sweeping separate batches). The
+  // first exception thrown by the body is rethrown once all threads have finished.
+  template <typename F>
+  void parallelFor(std::size_t n, std::size_t grain, F&& f) {
+    if (n == 0)
+      return;
+    if (grain == 0)
+      grain = 1;
+    if (numWorkers_.load(std::memory_order_relaxed) == 0 || n <= grain || insideLoop_) {
+      f(std::size_t{0}, n);
+      return;
+    }
+    run(n, grain, std::function<void(std::size_t, std::size_t)>(std::forward<F>(f)));
+  }
+
+private:
+  struct Share
+  {
+    std::mutex mutex;
+    std::size_t begin = 0; // chunk indices
+    std::size_t end   = 0;
+  };
+
+  struct Job
+  {
+    std::function<void(std::size_t, std::size_t)> body;
+    std::size_t n     = 0;
+    std::size_t grain = 0;
+    std::vector<Share> shares;
+    std::atomic<std::size_t> active{0};
+    std::atomic<bool> failed{false};
+    std::mutex exceptionMutex;
+    std::exception_ptr exception;
+  };
+
+  void run(std::size_t n, std::size_t grain, std::function<void(std::size_t, std::size_t)> body);
+  void participate(Job& job, std::size_t self);
+  bool nextChunk(Job& job, std::size_t self, std::size_t& chunk);
+  void workerLoop(std::size_t self, std::size_t seenGeneration);
+  void start(std::size_t numWorkers);
+  void stop();
+
+  std::vector<std::thread> workers_;
+  std::atomic<std::size_t> numWorkers_{0}; // size of workers_, readable without runMutex_ while resize() rewrites it
+  std::mutex runMutex_;                    // held by the thread whose job the workers run, and by resize()
+  std::mutex mutex_;
+  std::condition_variable wakeUp_;
+  std::condition_variable finished_;
+  std::shared_ptr<Job> job_;
+  std::size_t generation_ = 0;
+  bool shutdown_          = false;
+
+  static thread_local bool insideLoop_;
+};
+
+// Chunk size used by the batch engines when splitting material points across threads
+inline constexpr std::size_t batchGrainSize = 64;
@@ -35,17 +35,41 @@ using MaterialProperties = MultiMapWrapper;
 template <typename TensorType>
 struct ArrayOfTensorsT
 {
-  using JuliaTensor = jlcxx::ArrayRef<double, 2>;
+  using JuliaTensor      = jlcxx::ArrayRef<double, 2>;
+  using JuliaTensorBatch = jlcxx::ArrayRef<double, 3>;
+
+  ArrayOfTensorsT() = default;
+
+  // Bulk construction, see append
+  explicit ArrayOfTensorsT(JuliaTensorBatch tensors);
+  explicit ArrayOfTensorsT(JuliaTensor voigt);
 
   void pushTensor(JuliaTensor tensor);
 
+  // Appends the tensors of a 3 x 3 x N array, or of a 6 x N Voigt matrix (symmetric tensors only, with engineering
+  // shear components as for strains, see layout.hh)
+  void append(JuliaTensorBatch tensors);
+  void append(JuliaTensor voigt);
+
+  void reserve(size_t n);
+
   void clear();
 
   size_t size() const;
 
+  // 3 x 3 x N view on the stored tensors without copying, symmetric tensors only. muesli stores a tensor row by row,
+  // which only coincides with the column-major Julia slice for symmetric tensors, and the layout is checked once at
+  // run time. The view is invalidated by push!, append! and clear!.
+  jlcxx::ArrayRef<double, 3> view();
+
+  // Copies the stored tensors column-major into a 3 x 3 x N array
+  void copyTo(JuliaTensorBatch out) const;
+
   const std::vector<TensorType>& tensors() const;
 
 private:
+  void appendComponents(const double* data, size_t components, size_t n);
+
   std::vector<TensorType> tensors_{};
 };
 
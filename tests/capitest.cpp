@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// The C API of jlmuesli.h: handles, the batch operations against single muesli points, status codes and error
+// reporting.
+
+#include "testing.hh"
+
+#include <jlmuesli/capi/jlmuesli.h>
+#include <jlmuesli/util/layout.hh>
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <muesli/muesli.h>
+
+namespace {
+constexpr double E  = 210000.0;
+constexpr double nu = 0.3;
+
+jlmuesli_material* createElastic() {
+  const char* keys[]     = {"young", "poisson"};
+  const double values[]  = {E, nu};
+  jlmuesli_material* mat = nullptr;
+  CHECK(jlmuesli_material_create("ElasticIsotropic", keys, values, 2, &mat) == JLMUESLI_OK);
+  return mat;
+}
+
+void testHandles() {
+  CHECK(jlmuesli_api_version() == JLMUESLI_C_API_VERSION);
+
+  jlmuesli_material* material = nullptr;
+  CHECK(jlmuesli_material_create("NoSuchModel", nullptr, nullptr, 0, &material) == JLMUESLI_INVALID_ARGUMENT);
+  CHECK(material == nullptr);
+  CHECK(std::strlen(jlmuesli_last_error()) > 0);
+
+  material = createElastic();
+  CHECK(std::strlen(jlmuesli_last_error()) == 0);
+  CHECK(jlmuesli_material_finite_strain(material) == 0);
+
+  jlmuesli_batch* batch = nullptr;
+  CHECK(jlmuesli_batch_create(material, 5, &batch) == JLMUESLI_OK);
+  CHECK(jlmuesli_batch_size(batch) == 5);
+  CHECK(jlmuesli_batch_finite_strain(batch) == 0);
+  CHECK(jlmuesli_batch_commit(nullptr) == JLMUESLI_INVALID_ARGUMENT);
+  CHECK(jlmuesli_batch_size(nullptr) == 0);
+
+  jlmuesli_batch_destroy(batch);
+  jlmuesli_material_destroy(material);
+}
+
+void testBatchOperations() {
+  const std::size_t n         = 4;
+  jlmuesli_material* material = createElastic();
+  jlmuesli_batch* batch       = nullptr;
+  CHECK(jlmuesli_batch_create(material, n, &batch) == JLMUESLI_OK);
+
+  std::vector<double> strain(6 * n, 0.0);
+  for (std::size_t i = 0; i < n; ++i) {
+    strain[6 * i]     = 1.0e-3 * static_cast<double>(i + 1);
+    strain[6 * i + 5] = 2.0e-4;
+  }
+  std::vector<double> stress(6 * n), tangent(36 * n), energy(n);
+  CHECK(jlmuesli_batch_evaluate(batch, 1.0, strain.data(), stress.data(), 6, tangent.data(), JLMUESLI_TANGENT_VOIGT,
+                                energy.data(), n) == JLMUESLI_OK);
+
+  const muesli::elasticIsotropicMaterial reference{"ElasticIsotropic", E, nu, 1.0};
+  istensor S;
+  itensor4 C;
+  double expected[36];
+  for (std::size_t i = 0; i < n; ++i) {
+    muesli::elasticIsotropicMP mp(reference);
+    mp.updateCurrentState(1.0, strainFromVoigt(strain.data() + 6 * i));
+    mp.stress(S);
+    writeStressVoigt(S, expected);
+    for (std::size_t a = 0; a < 6; ++a)
+      CHECK_NEAR(stress[6 * i + a], expected[a], 1e-10);
+    mp.tangentTensor(C);
+    writeVoigt(C, expected);
+    for (std::size_t m = 0; m < 36; ++m)
+      CHECK_NEAR(tangent[36 * i + m], expected[m], 1e-10);
+    CHECK_NEAR(energy[i], mp.storedEnergy(), 1e-10);
+  }
+
+  // The separate calls agree with evaluate
+  std::vector<double> stress2(6 * n), packed(21 * n), energy2(n);
+  CHECK(jlmuesli_batch_update(batch, 1.0, strain.data(), 6, strain.size()) == JLMUESLI_OK);
+  CHECK(jlmuesli_batch_stress(batch, stress2.data(), 6, stress2.size()) == JLMUESLI_OK);
+  CHECK(jlmuesli_batch_tangent(batch, packed.data(), JLMUESLI_TANGENT_PACKED, packed.size()) == JLMUESLI_OK);
+  CHECK(jlmuesli_batch_energy(batch, energy2.data(), energy2.size()) == JLMUESLI_OK);
+  for (std::size_t m = 0; m < stress.size(); ++m)
+    CHECK_NEAR(stress2[m], stress[m], 1e-10);
+  for (std::size_t i = 0; i < n; ++i) {
+    CHECK_NEAR(energy2[i], energy[i], 1e-10);
+    CHECK_NEAR(packed[21 * i + 1], tangent[36 * i + 6], 1e-10);
+  }
+
+  // Invalid arguments are reported, not thrown
+  CHECK(jlmuesli_batch_update(batch, 1.0, strain.data(), 6, strain.size() - 1) == JLMUESLI_INVALID_ARGUMENT);
+  CHECK(jlmuesli_batch_stress(batch, stress.data(), 7, stress.size()) == JLMUESLI_INVALID_ARGUMENT);
+  CHECK(jlmuesli_batch_tangent(batch, tangent.data(), 3, tangent.size()) == JLMUESLI_INVALID_ARGUMENT);
+  CHECK(jlmuesli_batch_evaluate(batch, 1.0, strain.data(), stress.data(), 6, tangent.data(), JLMUESLI_TANGENT_VOIGT,
+                                energy.data(), n + 1) == JLMUESLI_INVALID_ARGUMENT);
+  CHECK(jlmuesli_batch_status(batch, nullptr, 0, nullptr) == JLMUESLI_UNSUPPORTED);
+
+  jlmuesli_batch_destroy(batch);
+  jlmuesli_material_destroy(material);
+}
+
+void testFiniteStrain() {
+  const char* keys[]          = {"young", "poisson", "isotropich", "kinematich", "yieldstress", "yieldinf", "hardexp"};
+  const double values[]       = {E, nu, 1000.0, 0.0, 250.0, 250.0, 0.0};
+  jlmuesli_material* material = nullptr;
+  CHECK(jlmuesli_material_create("Fplastic", keys, values, 7, &material) == JLMUESLI_OK);
+  CHECK(jlmuesli_material_finite_strain(material) == 1);
+  jlmuesli_batch* batch = nullptr;
+  CHECK(jlmuesli_batch_create(material, 2, &batch) == JLMUESLI_OK);
+
+  const double F[18] = {1.01, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+  std::vector<double> S(12), packed(42), energy(2);
+  CHECK(jlmuesli_batch_update(batch, 1.0, F, 6, 12) == JLMUESLI_INVALID_ARGUMENT);
+  CHECK(jlmuesli_batch_update(batch, 1.0, F, 9, 18) == JLMUESLI_OK);
+  CHECK(jlmuesli_batch_stress(batch, S.data(), 6, S.size()) == JLMUESLI_OK);
+  CHECK(S[0] > 0.0);
+  CHECK(S[6] == 0.0);
+  // The convected tangent of fplastic may lack major symmetry
+  CHECK(jlmuesli_batch_tangent(batch, packed.data(), JLMUESLI_TANGENT_PACKED, packed.size()) == JLMUESLI_UNSUPPORTED);
+  CHECK(jlmuesli_batch_evaluate(batch, 1.0, F, S.data(), 6, packed.data(), JLMUESLI_TANGENT_PACKED, energy.data(),
+                                2) == JLMUESLI_UNSUPPORTED);
+
+  jlmuesli_batch_destroy(batch);
+  jlmuesli_material_destroy(material);
+}
+
+void testStatus() {
+  const std::size_t n         = 3;
+  jlmuesli_material* material = createElastic();
+  jlmuesli_batch* batch       = nullptr;
+  CHECK(jlmuesli_batch_create(material, n, &batch) == JLMUESLI_OK);
+  CHECK(jlmuesli_batch_set_status_tracking(batch, 1) == JLMUESLI_OK);
+
+  std::vector<double> strain(6 * n, 1.0e-3), stress(6 * n), tangent(81 * n), energy(n);
+  strain[6 * 1 + 2] = std::numeric_limits<double>::quiet_NaN();
+  CHECK(jlmuesli_batch_evaluate(batch, 1.0, strain.data(), stress.data(), 6, tangent.data(), JLMUESLI_TANGENT_FULL,
+                                energy.data(), n) == JLMUESLI_OK);
+
+  unsigned char status[n] = {};
+  std::size_t failures    = 0;
+  CHECK(jlmuesli_batch_status(batch, status, n, &failures) == JLMUESLI_OK);
+  CHECK(failures == 1);
+  CHECK(status[0] == JLMUESLI_POINT_CONVERGED && status[2] == JLMUESLI_POINT_CONVERGED);
+  CHECK(status[1] == JLMUESLI_POINT_NON_FINITE);
+  // The failed point reports its converged, here virgin, response
+  for (std::size_t a = 0; a < 6; ++a)
+    CHECK(stress[6 * 1 + a] == 0.0);
+  CHECK(energy[1] == 0.0);
+  CHECK(stress[0] > 0.0);
+
+  // Substeps are only reported with substepping enabled
+  unsigned int substeps[n] = {};
+  CHECK(jlmuesli_batch_substeps(batch, substeps, n) == JLMUESLI_UNSUPPORTED);
+
+  jlmuesli_batch_destroy(batch);
+  jlmuesli_material_destroy(material);
+}
+} // namespace
+
+int main() {
+  testHandles();
+  testBatchOperations();
+  testFiniteStrain();
+  testStatus();
+  return testResult();
+}
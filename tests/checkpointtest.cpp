@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Checkpoint round trip, and corrupt or truncated files rejected with std::runtime_error instead of being read out of
+// bounds.
+
+#include "testing.hh"
+
+#include <jlmuesli/util/checkpoint.hh>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <muesli/muesli.h>
+
+namespace {
+const std::string path    = "jlmuesli_checkpointtest.bin";
+const std::string corrupt = "jlmuesli_checkpointtest_corrupt.bin";
+
+// Header: magic, version, byte order mark, n, tag length and the tag "tag" padded to 8 bytes
+constexpr std::size_t offsetsStart = 8 + 4 + 4 + 8 + 8 + 8;
+constexpr std::size_t recordsStart = offsetsStart + 3 * 8;
+
+std::vector<char> readFile(const std::string& name) {
+  std::ifstream in(name, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Writes bytes with value at position and reads every record back
+void readPatched(std::vector<char> bytes, std::size_t position, std::uint64_t value) {
+  std::memcpy(bytes.data() + position, &value, sizeof(value));
+  {
+    std::ofstream out(corrupt, std::ios::binary);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  }
+  CheckpointReader reader(corrupt);
+  for (std::size_t i = 0; i < reader.size(); ++i)
+    reader.state(i);
+}
+
+void testRoundTrip() {
+  {
+    CheckpointWriter writer(path, "tag", 2);
+    muesli::materialState state;
+    state.theTime   = 1.5;
+    state.theDouble = {1.0, 2.0, 3.0};
+    writer.write(state);
+    state.theDouble = {4.0};
+    writer.write(state);
+    writer.finish();
+  }
+  CheckpointReader reader(path);
+  CHECK(reader.size() == 2);
+  CHECK(reader.typeTag() == "tag");
+  CHECK(reader.state(0).theTime == 1.5);
+  CHECK(reader.state(0).theDouble.size() == 3);
+  CHECK(reader.state(1).theDouble.size() == 1 && reader.state(1).theDouble[0] == 4.0);
+  CHECK_THROWS(reader.state(2), std::out_of_range);
+}
+
+void testCorruptFiles() {
+  const std::vector<char> bytes = readFile(path);
+  // Number of points, tag length, first record offset, end offset, a huge count and a count beyond the record
+  CHECK_THROWS(readPatched(bytes, 16, ~std::uint64_t(0) / 4), std::runtime_error);
+  CHECK_THROWS(readPatched(bytes, 24, ~std::uint64_t(0)), std::runtime_error);
+  CHECK_THROWS(readPatched(bytes, offsetsStart, 1000), std::runtime_error);
+  CHECK_THROWS(readPatched(bytes, offsetsStart + 16, 1u << 30), std::runtime_error);
+  CHECK_THROWS(readPatched(bytes, recordsStart + 8, std::uint64_t(1) << 60), std::runtime_error);
+  CHECK_THROWS(readPatched(bytes, recordsStart + 8, 4), std::runtime_error);
+
+  std::vector<char> truncated = bytes;
+  truncated.resize(bytes.size() - 8);
+  {
+    std::ofstream out(corrupt, std::ios::binary);
+    out.write(truncated.data(), static_cast<std::streamsize>(truncated.size()));
+  }
+  CHECK_THROWS(CheckpointReader{corrupt}, std::runtime_error);
+}
+} // namespace
+
+int main() {
+  testRoundTrip();
+  testCorruptFiles();
+  std::remove(path.c_str());
+  std::remove(corrupt.c_str());
+  return testResult();
+}
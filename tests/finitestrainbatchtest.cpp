@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// FiniteStrainMPBatch against single muesli points: the stress measures, tangents and the bucketed sweep of fplastic.
+
+#include "testing.hh"
+
+#include <jlmuesli/finitestrain/finitestrainbatch.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <muesli/Finitestrain/fplastic.h>
+#include <muesli/muesli.h>
+
+namespace {
+constexpr double E     = 210000.0;
+constexpr double nu    = 0.3;
+constexpr double rho   = 1.0;
+constexpr double yield = 250.0;
+
+// Column-major deformation gradients, point i is stretched by amplitude(i) times the yield strain at t = 1
+std::vector<double> deformations(std::size_t n, double t) {
+  std::vector<double> F(9 * n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const double x    = t * (i % 3 == 0 ? 5.0 : 0.5) * yield / E;
+    const double Fi[9] = {1.0 + x, 0.0, 0.0, 0.2 * x, 1.0 - 0.3 * x, 0.0, 0.0, 0.1 * x, 1.0 - 0.3 * x};
+    std::copy(Fi, Fi + 9, F.begin() + 9 * i);
+  }
+  return F;
+}
+
+muesli::fplasticMaterial fplasticMaterial() {
+  const muesli::materialProperties properties{
+      {      "young",      E},
+      {    "poisson",     nu},
+      { "isotropich", 1000.0},
+      { "kinematich",    0.0},
+      {"yieldstress",  yield},
+      {   "yieldinf",  yield},
+      {    "hardexp",    0.0},
+      {  "softening",    0.0}
+  };
+  return muesli::fplasticMaterial{"Fplastic", properties};
+}
+
+template <typename MaterialPoint, typename Material>
+void checkAgainstPoints(const Material& material, std::size_t steps) {
+  const std::size_t n = 7;
+  FiniteStrainMPBatch<Material, MaterialPoint> batch(material, n);
+  std::vector<MaterialPoint> points(n, MaterialPoint(material));
+  std::vector<double> S(6 * n), C(36 * n), energy(n), P(9 * n), sigma(9 * n), c(36 * n);
+
+  for (std::size_t step = 1; step <= steps; ++step) {
+    const double t              = static_cast<double>(step) / static_cast<double>(steps);
+    const std::vector<double> F = deformations(n, t);
+    batch.evaluate(t, F.data(), S.data(), 6, C.data(), TangentLayout::Voigt, energy.data());
+    batch.firstPiolaKirchhoffStress(P.data());
+    batch.CauchyStress(sigma.data(), 9);
+    batch.spatialTangent(c.data(), TangentLayout::Voigt);
+
+    istensor stress;
+    itensor firstPK;
+    itensor4 T;
+    double expected[36];
+    for (std::size_t i = 0; i < n; ++i) {
+      auto& mp = points[i];
+      mp.updateCurrentState(t, itensorFromColumnMajor(F.data() + 9 * i));
+      mp.secondPiolaKirchhoffStress(stress);
+      writeStressVoigt(stress, expected);
+      for (std::size_t a = 0; a < 6; ++a)
+        CHECK_NEAR(S[6 * i + a], expected[a], 1e-10);
+      mp.convectedTangent(T);
+      writeVoigt(T, expected);
+      for (std::size_t m = 0; m < 36; ++m)
+        CHECK_NEAR(C[36 * i + m], expected[m], 1e-10);
+      CHECK_NEAR(energy[i], mp.storedEnergy(), 1e-10);
+
+      mp.firstPiolaKirchhoffStress(firstPK);
+      writeColumnMajor(firstPK, expected);
+      for (std::size_t m = 0; m < 9; ++m)
+        CHECK_NEAR(P[9 * i + m], expected[m], 1e-10);
+      mp.CauchyStress(stress);
+      writeColumnMajor(stress, expected);
+      for (std::size_t m = 0; m < 9; ++m)
+        CHECK_NEAR(sigma[9 * i + m], expected[m], 1e-10);
+      mp.spatialTangent(T);
+      writeVoigt(T, expected);
+      for (std::size_t m = 0; m < 36; ++m)
+        CHECK_NEAR(c[36 * i + m], expected[m], 1e-10);
+      mp.commitCurrentState();
+    }
+    batch.commitCurrentState();
+  }
+}
+
+void testHyperelasticSweeps() {
+  checkAgainstPoints<muesli::neohookeanMP>(muesli::neohookeanMaterial{"NeoHooke", E, nu, rho}, 2);
+  checkAgainstPoints<muesli::svkMP>(
+      muesli::svkMaterial{"SVK", muesli::materialProperties{{"young", E}, {"poisson", nu}}}, 2);
+}
+
+void testPlasticSweeps() {
+  const muesli::fplasticMaterial material = fplasticMaterial();
+  checkAgainstPoints<muesli::fplasticMP>(material, 4);
+
+  // Bucketing only reorders the work
+  const std::size_t n = 12, steps = 4;
+  FiniteStrainMPBatch<muesli::fplasticMaterial, muesli::fplasticMP> plain(material, n), bucketed(material, n);
+  bucketed.setBucketing(true);
+  std::vector<double> S(9 * n), C(81 * n), energy(n), SB(9 * n), CB(81 * n), energyB(n);
+  for (std::size_t step = 1; step <= steps; ++step) {
+    const double t              = static_cast<double>(step) / static_cast<double>(steps);
+    const std::vector<double> F = deformations(n, t);
+    plain.evaluate(t, F.data(), S.data(), 9, C.data(), TangentLayout::Full, energy.data());
+    bucketed.evaluate(t, F.data(), SB.data(), 9, CB.data(), TangentLayout::Full, energyB.data());
+    for (std::size_t m = 0; m < S.size(); ++m)
+      CHECK_NEAR(SB[m], S[m], 1e-10);
+    for (std::size_t m = 0; m < C.size(); ++m)
+      CHECK_NEAR(CB[m], C[m], 1e-10);
+    for (std::size_t i = 0; i < n; ++i)
+      CHECK_NEAR(energyB[i], energy[i], 1e-10);
+    plain.commitCurrentState();
+    bucketed.commitCurrentState();
+  }
+
+  // The convected tangent of fplastic has no major symmetry in general
+  std::vector<double> packed(21 * n);
+  CHECK_THROWS(plain.convectedTangent(packed.data(), TangentLayout::Packed), std::logic_error);
+  CHECK_THROWS(plain.evaluate(1.0, deformations(n, 1.0).data(), S.data(), 6, packed.data(), TangentLayout::Packed,
+                              energy.data()),
+               std::logic_error);
+}
+} // namespace
+
+int main() {
+  testHyperelasticSweeps();
+  testPlasticSweeps();
+  return testResult();
+}
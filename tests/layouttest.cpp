@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Round trips of the conversions in layout.hh, which the array converters of the jlcxx module (common.hh, utils.hh)
+// and the C API write through.
+
+#include "testing.hh"
+
+#include <jlmuesli/util/layout.hh>
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <muesli/muesli.h>
+
+namespace {
+constexpr double lambda = 100.0;
+constexpr double mu     = 40.0;
+
+double delta(std::size_t i, std::size_t j) { return i == j ? 1.0 : 0.0; }
+
+itensor4 isotropicTangent() {
+  itensor4 C;
+  for (std::size_t i = 0; i < 3; ++i)
+    for (std::size_t j = 0; j < 3; ++j)
+      for (std::size_t k = 0; k < 3; ++k)
+        for (std::size_t l = 0; l < 3; ++l)
+          C(i, j, k, l) =
+              lambda * delta(i, j) * delta(k, l) + mu * (delta(i, k) * delta(j, l) + delta(i, l) * delta(j, k));
+  return C;
+}
+
+void testTensorRoundTrips() {
+  // Distinct entries, so a transposed layout shows up
+  const double data[9] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0};
+  const itensor F      = itensorFromColumnMajor(data);
+  CHECK(F(1, 0) == 2.0);
+  CHECK(F(0, 1) == 4.0);
+  double out[9] = {};
+  writeColumnMajor(F, out);
+  for (std::size_t m = 0; m < 9; ++m)
+    CHECK(out[m] == data[m]);
+
+  const double symmetric[9] = {1.0, 6.0, 5.0, 6.0, 2.0, 4.0, 5.0, 4.0, 3.0};
+  const istensor S          = istensorFromColumnMajor(symmetric);
+  writeStressComponents(S, out, 9);
+  for (std::size_t m = 0; m < 9; ++m)
+    CHECK(out[m] == symmetric[m]);
+  writeStressComponents(S, out, 6);
+  const double voigt[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+  for (std::size_t a = 0; a < 6; ++a)
+    CHECK(out[a] == voigt[a]);
+}
+
+void testStrainComponents() {
+  // Voigt strains carry engineering shear, 9 components the tensor itself
+  const double engineering[6] = {1.0, 2.0, 3.0, 0.8, 1.0, 1.2};
+  const istensor e            = strainFromComponents(engineering, 6);
+  CHECK(e(1, 2) == 0.4);
+  CHECK(e(0, 2) == 0.5);
+  CHECK(e(0, 1) == 0.6);
+
+  double full[9] = {};
+  writeColumnMajor(e, full);
+  const istensor f = strainFromComponents(full, 9);
+  for (std::size_t i = 0; i < 3; ++i)
+    for (std::size_t j = 0; j < 3; ++j)
+      CHECK(f(i, j) == e(i, j));
+}
+
+void testTangentLayouts() {
+  CHECK(tangentComponents(TangentLayout::Full) == 81);
+  CHECK(tangentComponents(TangentLayout::Voigt) == 36);
+  CHECK(tangentComponents(TangentLayout::Packed) == 21);
+
+  const itensor4 C = isotropicTangent();
+  double full[81] = {}, voigt[36] = {}, packed[21] = {};
+  writeTangent(C, full, TangentLayout::Full);
+  writeTangent(C, voigt, TangentLayout::Voigt);
+  writeTangent(C, packed, TangentLayout::Packed);
+
+  for (std::size_t l = 0; l < 3; ++l)
+    for (std::size_t k = 0; k < 3; ++k)
+      for (std::size_t j = 0; j < 3; ++j)
+        for (std::size_t i = 0; i < 3; ++i)
+          CHECK(full[i + 3 * j + 9 * k + 27 * l] == C(i, j, k, l));
+
+  // stress = C * strain in Voigt notation with engineering shear
+  for (std::size_t b = 0; b < 6; ++b)
+    for (std::size_t a = 0; a < 6; ++a) {
+      const double expected = a == b ? (a < 3 ? lambda + 2.0 * mu : mu) : (a < 3 && b < 3 ? lambda : 0.0);
+      CHECK_NEAR(voigt[a + 6 * b], expected, 1e-14);
+    }
+
+  // Packed holds the upper triangle row by row
+  for (std::size_t m = 0, a = 0; a < 6; ++a)
+    for (std::size_t b = a; b < 6; ++b, ++m)
+      CHECK(packed[m] == voigt[a + 6 * b]);
+}
+
+void testMajorSymmetry() {
+  itensor4 C = isotropicTangent();
+  CHECK(hasMajorSymmetry(C));
+  C(0, 0, 1, 1) += 10.0;
+  CHECK(!hasMajorSymmetry(C));
+#ifndef NDEBUG
+  double packed[21] = {};
+  CHECK_THROWS(writePacked(C, packed), std::invalid_argument);
+#endif
+  // The Voigt layout keeps the non-symmetric part
+  double voigt[36] = {};
+  writeVoigt(C, voigt);
+  CHECK_NEAR(voigt[0 + 6 * 1] - voigt[1 + 6 * 0], 10.0, 1e-14);
+}
+} // namespace
+
+int main() {
+  testTensorRoundTrips();
+  testStrainComponents();
+  testTangentLayouts();
+  testMajorSymmetry();
+  return testResult();
+}
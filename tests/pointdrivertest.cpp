@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// The native load histories of pointdriver.hh: strain driven histories against a driving loop, failed steps with a
+// status output, and mixed stress/strain control.
+
+#include "testing.hh"
+
+#include <jlmuesli/util/pointdriver.hh>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <muesli/muesli.h>
+
+namespace {
+constexpr double E     = 210000.0;
+constexpr double nu    = 0.3;
+constexpr double rho   = 1.0;
+constexpr double yield = 250.0;
+
+const muesli::splasticMaterial splastic{"Splastic", E, nu, rho, 1000.0, 0.0, yield, 0.0, "mises"};
+
+// Uniaxial strain ramp to five times the yield strain, 6 Voigt components per step
+std::vector<double> strainHistory(std::size_t steps, std::vector<double>& times) {
+  std::vector<double> strain(6 * steps, 0.0);
+  times.resize(steps);
+  for (std::size_t s = 0; s < steps; ++s) {
+    times[s]      = static_cast<double>(s + 1) / static_cast<double>(steps);
+    strain[6 * s] = times[s] * 5.0 * yield / E;
+  }
+  return strain;
+}
+
+void testSmallStrainHistory() {
+  const std::size_t steps = 8;
+  std::vector<double> times;
+  const std::vector<double> strain = strainHistory(steps, times);
+  std::vector<double> stress(6 * steps), energy(steps);
+  PointHistoryOutput out;
+  out.stress = stress.data();
+  out.energy = energy.data();
+  CHECK(driveSmallStrainPoint<muesli::splasticMP>(splastic, steps, times.data(), strain.data(), 6, out) == steps);
+
+  muesli::splasticMP mp(splastic);
+  istensor S;
+  double expected[6];
+  for (std::size_t s = 0; s < steps; ++s) {
+    mp.updateCurrentState(times[s], strainFromVoigt(strain.data() + 6 * s));
+    mp.stress(S);
+    writeStressVoigt(S, expected);
+    for (std::size_t a = 0; a < 6; ++a)
+      CHECK_NEAR(stress[6 * s + a], expected[a], 1e-10);
+    CHECK_NEAR(energy[s], mp.storedEnergy(), 1e-10);
+    mp.commitCurrentState();
+  }
+}
+
+void testFailedSteps() {
+  // A non-finite strain stops the history, the failed step reports the response of the last converged step
+  const std::size_t steps = 4;
+  std::vector<double> times;
+  std::vector<double> strain = strainHistory(steps, times);
+  strain[6 * 2 + 1]          = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> stress(6 * steps, -1.0), energy(steps, -1.0);
+  std::vector<unsigned char> status(steps, PS_CONVERGED);
+  PointHistoryOutput out;
+  out.stress = stress.data();
+  out.energy = energy.data();
+  out.status = status.data();
+  CHECK(driveSmallStrainPoint<muesli::splasticMP>(splastic, steps, times.data(), strain.data(), 6, out) == 2);
+  CHECK(status[0] == PS_CONVERGED && status[1] == PS_CONVERGED);
+  CHECK(status[2] == PS_NON_FINITE);
+  for (std::size_t a = 0; a < 6; ++a)
+    CHECK(stress[6 * 2 + a] == stress[6 * 1 + a]);
+  CHECK(energy[2] == energy[1]);
+  CHECK(stress[6 * 3] == -1.0);
+
+  // An inverted deformation gradient in the first step leaves the virgin response
+  const muesli::neohookeanMaterial neohookean{"NeoHooke", E, nu, rho};
+  const double F[9]   = {-1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+  const double time   = 1.0;
+  double S[6]         = {-1.0, -1.0, -1.0, -1.0, -1.0, -1.0};
+  unsigned char code  = PS_CONVERGED;
+  PointHistoryOutput finite;
+  finite.flags  = EVAL_STRESS;
+  finite.stress = S;
+  finite.status = &code;
+  CHECK(driveFiniteStrainPoint<muesli::neohookeanMP>(neohookean, 1, &time, F, finite) == 0);
+  CHECK(code == PS_NEGATIVE_JACOBIAN);
+  for (const double s : S)
+    CHECK_NEAR(s, 0.0, 1e-10);
+}
+
+void testMixedControl() {
+  // Uniaxial stress in an elastic point: only the axial strain is prescribed, all other stresses vanish
+  const muesli::elasticIsotropicMaterial elastic{"ElasticIsotropic", E, nu, rho};
+  const std::size_t steps               = 3;
+  const unsigned char control[6]        = {0, 1, 1, 1, 1, 1};
+  std::vector<double> prescribed(6 * steps, 0.0), times(steps);
+  for (std::size_t s = 0; s < steps; ++s) {
+    times[s]          = static_cast<double>(s + 1);
+    prescribed[6 * s] = 1.0e-3 * times[s];
+  }
+  std::vector<double> strain(6 * steps), stress(6 * steps), residual(steps);
+  std::vector<std::int64_t> iterations(steps);
+  MixedHistoryOutput out;
+  out.strain     = strain.data();
+  out.stress     = stress.data();
+  out.iterations = iterations.data();
+  out.residual   = residual.data();
+  CHECK(driveSmallStrainMixed<muesli::elasticIsotropicMP>(elastic, steps, times.data(), control, prescribed.data(),
+                                                          NewtonOptions{}, out) == steps);
+  for (std::size_t s = 0; s < steps; ++s) {
+    const double axial = prescribed[6 * s];
+    CHECK_NEAR(strain[6 * s + 1], -nu * axial, 1e-10);
+    CHECK_NEAR(strain[6 * s + 2], -nu * axial, 1e-10);
+    CHECK_NEAR(stress[6 * s], E * axial, 1e-8);
+    for (std::size_t a = 1; a < 6; ++a)
+      CHECK(std::abs(stress[6 * s + a]) <= NewtonOptions{}.tolerance);
+    CHECK(residual[s] <= NewtonOptions{}.tolerance);
+  }
+
+  // A non-finite prescribed stress stops the history instead of passing as converged
+  std::vector<unsigned char> status(steps, PS_CONVERGED);
+  out.status            = status.data();
+  prescribed[6 * 1 + 2] = std::numeric_limits<double>::quiet_NaN();
+  CHECK(driveSmallStrainMixed<muesli::elasticIsotropicMP>(elastic, steps, times.data(), control, prescribed.data(),
+                                                          NewtonOptions{}, out) == 1);
+  CHECK(status[0] == PS_CONVERGED);
+  CHECK(status[1] == PS_NON_FINITE);
+  CHECK(std::isnan(residual[1]));
+}
+} // namespace
+
+int main() {
+  testSmallStrainHistory();
+  testFailedSteps();
+  testMixedControl();
+  return testResult();
+}
@@ -0,0 +1,196 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// SmallStrainMPBatch against single muesli points: the sweeps, tangent layouts, caching, commit and reset, and the
+// bucketed sweep of the plasticity models.
+
+#include "testing.hh"
+
+#include <jlmuesli/smallstrain/smallstrainbatch.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <muesli/Smallstrain/sdamage.h>
+#include <muesli/muesli.h>
+
+namespace {
+constexpr double E     = 210000.0;
+constexpr double nu    = 0.3;
+constexpr double rho   = 1.0;
+constexpr double yield = 250.0;
+
+// Distinct strains per point, point i reaches amplitude(i) times the yield strain at t = 1
+std::vector<double> voigtStrains(std::size_t n, double t, double (*amplitude)(std::size_t)) {
+  std::vector<double> strain(6 * n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const double x = t * amplitude(i) * yield / E;
+    const double e[6] = {x, -0.2 * x, -0.1 * x, 0.1 * x, 0.0, 0.3 * x};
+    std::copy(e, e + 6, strain.begin() + 6 * i);
+  }
+  return strain;
+}
+
+double mixedAmplitude(std::size_t i) { return i % 3 == 0 ? 5.0 : 0.5; }
+
+// The response of the batch matches points driven through the same strains one by one
+template <typename MaterialPoint, typename Material>
+void checkAgainstPoints(const Material& material, std::size_t steps) {
+  const std::size_t n = 7;
+  SmallStrainMPBatch<Material, MaterialPoint> batch(material, n);
+  std::vector<MaterialPoint> points(n, MaterialPoint(material));
+  std::vector<double> sigma(6 * n), C(36 * n), energy(n);
+
+  for (std::size_t step = 1; step <= steps; ++step) {
+    const double t                  = static_cast<double>(step) / static_cast<double>(steps);
+    const std::vector<double> strain = voigtStrains(n, t, mixedAmplitude);
+    batch.evaluate(t, strain.data(), sigma.data(), 6, C.data(), TangentLayout::Voigt, energy.data());
+
+    istensor S;
+    itensor4 T;
+    double expected[36];
+    for (std::size_t i = 0; i < n; ++i) {
+      points[i].updateCurrentState(t, strainFromVoigt(strain.data() + 6 * i));
+      points[i].stress(S);
+      writeStressVoigt(S, expected);
+      for (std::size_t a = 0; a < 6; ++a)
+        CHECK_NEAR(sigma[6 * i + a], expected[a], 1e-10);
+      points[i].tangentTensor(T);
+      writeVoigt(T, expected);
+      for (std::size_t m = 0; m < 36; ++m)
+        CHECK_NEAR(C[36 * i + m], expected[m], 1e-10);
+      CHECK_NEAR(energy[i], points[i].storedEnergy(), 1e-10);
+      points[i].commitCurrentState();
+    }
+    batch.commitCurrentState();
+  }
+}
+
+void testElasticSweeps() {
+  const muesli::elasticIsotropicMaterial material{"ElasticIsotropic", E, nu, rho};
+  checkAgainstPoints<muesli::elasticIsotropicMP>(material, 2);
+
+  // Separate update, stress and tangent calls agree with evaluate, in every layout and for 9 components
+  const std::size_t n = 5;
+  SmallStrainMPBatch<muesli::elasticIsotropicMaterial, muesli::elasticIsotropicMP> batch(material, n);
+  const std::vector<double> strain = voigtStrains(n, 1.0, mixedAmplitude);
+  std::vector<double> sigma(6 * n), C(81 * n), energy(n);
+  batch.evaluate(1.0, strain.data(), sigma.data(), 6, C.data(), TangentLayout::Full, energy.data());
+
+  std::vector<double> full(9 * n), stress9(9 * n), voigt(36 * n), packed(21 * n), tangent(81 * n);
+  for (std::size_t i = 0; i < n; ++i)
+    writeColumnMajor(strainFromVoigt(strain.data() + 6 * i), full.data() + 9 * i);
+  batch.updateCurrentState(1.0, full.data(), 9);
+  batch.stress(stress9.data(), 9);
+  batch.tangentTensor(tangent.data(), TangentLayout::Full);
+  batch.tangentTensor(voigt.data(), TangentLayout::Voigt);
+  batch.tangentTensor(packed.data(), TangentLayout::Packed);
+  for (std::size_t i = 0; i < n; ++i) {
+    const istensor S = istensorFromColumnMajor(stress9.data() + 9 * i);
+    double S6[6];
+    writeStressVoigt(S, S6);
+    for (std::size_t a = 0; a < 6; ++a)
+      CHECK_NEAR(S6[a], sigma[6 * i + a], 1e-10);
+    for (std::size_t m = 0; m < 81; ++m)
+      CHECK_NEAR(tangent[81 * i + m], C[81 * i + m], 1e-10);
+    for (std::size_t m = 0, a = 0; a < 6; ++a)
+      for (std::size_t b = a; b < 6; ++b, ++m)
+        CHECK_NEAR(packed[21 * i + m], voigt[36 * i + a + 6 * b], 1e-10);
+  }
+}
+
+void testCaching() {
+  const muesli::elasticIsotropicMaterial material{"ElasticIsotropic", E, nu, rho};
+  const std::size_t n = 4;
+  SmallStrainMPBatch<muesli::elasticIsotropicMaterial, muesli::elasticIsotropicMP> batch(material, n);
+  batch.setCaching(true);
+  const std::vector<double> strain = voigtStrains(n, 1.0, mixedAmplitude);
+  std::vector<double> first(6 * n), second(6 * n);
+  batch.updateCurrentState(1.0, strain.data(), 6);
+  batch.stress(first.data(), 6);
+  batch.stress(second.data(), 6);
+  CHECK(batch.cacheMisses() == n);
+  CHECK(batch.cacheHits() == n);
+  CHECK(first == second);
+
+  // An update invalidates the cache
+  batch.updateCurrentState(1.0, std::vector<double>(6 * n, 0.0).data(), 6);
+  batch.stress(second.data(), 6);
+  for (const double s : second)
+    CHECK(s == 0.0);
+}
+
+void testPlasticSweeps() {
+  const muesli::splasticMaterial material{"Splastic", E, nu, rho, 1000.0, 0.0, yield, 0.0, "mises"};
+  checkAgainstPoints<muesli::splasticMP>(material, 4);
+
+  // Reset returns to the converged state, commit makes the current state converged
+  const std::size_t n = 3;
+  SmallStrainMPBatch<muesli::splasticMaterial, muesli::splasticMP> batch(material, n);
+  const std::vector<double> strain = voigtStrains(n, 1.0, mixedAmplitude);
+  std::vector<double> sigma(6 * n);
+  batch.updateCurrentState(1.0, strain.data(), 6);
+  batch.resetCurrentState();
+  batch.stress(sigma.data(), 6);
+  for (const double s : sigma)
+    CHECK(s == 0.0);
+  batch.updateCurrentState(1.0, strain.data(), 6);
+  batch.commitCurrentState();
+  batch.resetCurrentState();
+  batch.stress(sigma.data(), 6);
+  CHECK(sigma[0] != 0.0);
+}
+
+// Bucketing only reorders the work, the results are those of the plain sweep
+template <typename MaterialPoint, typename Material>
+void checkBucketing(const Material& material) {
+  const std::size_t n = 12, steps = 4;
+  SmallStrainMPBatch<Material, MaterialPoint> plain(material, n), bucketed(material, n);
+  bucketed.setBucketing(true);
+  std::vector<double> sigma(6 * n), C(36 * n), energy(n), sigmaB(6 * n), CB(36 * n), energyB(n);
+  for (std::size_t step = 1; step <= steps; ++step) {
+    const double t                  = static_cast<double>(step) / static_cast<double>(steps);
+    const std::vector<double> strain = voigtStrains(n, t, mixedAmplitude);
+    plain.evaluate(t, strain.data(), sigma.data(), 6, C.data(), TangentLayout::Voigt, energy.data());
+    bucketed.evaluate(t, strain.data(), sigmaB.data(), 6, CB.data(), TangentLayout::Voigt, energyB.data());
+    for (std::size_t m = 0; m < sigma.size(); ++m)
+      CHECK_NEAR(sigmaB[m], sigma[m], 1e-10);
+    for (std::size_t m = 0; m < C.size(); ++m)
+      CHECK_NEAR(CB[m], C[m], 1e-10);
+    for (std::size_t i = 0; i < n; ++i)
+      CHECK_NEAR(energyB[i], energy[i], 1e-10);
+    plain.commitCurrentState();
+    bucketed.commitCurrentState();
+  }
+  CHECK(bucketed.bucketStatistics().size() == steps);
+}
+
+void testBucketing() {
+  checkBucketing<muesli::splasticMP>(
+      muesli::splasticMaterial{"Splastic", E, nu, rho, 1000.0, 0.0, yield, 0.0, "mises"});
+  checkBucketing<muesli::viscoplasticMP>(
+      muesli::viscoplasticMaterial{"Viscoplastic", E, nu, rho, 1000.0, 0.0, yield, "mises", 1.0e-3, 1.0});
+
+  const muesli::elasticIsotropicMaterial elastic{"ElasticIsotropic", E, nu, rho};
+  SmallStrainMPBatch<muesli::elasticIsotropicMaterial, muesli::elasticIsotropicMP> batch(elastic, 1);
+  CHECK_THROWS(batch.setBucketing(true), std::logic_error);
+}
+
+void testPackedRejected() {
+  const muesli::Lemaitre_Material material{"Lemaitre", E, nu, rho, 1.0, 1.0, yield, 100.0, 10.0};
+  SmallStrainMPBatch<muesli::Lemaitre_Material, muesli::Lemaitre_MP> batch(material, 2);
+  std::vector<double> C(21 * 2);
+  CHECK_THROWS(batch.tangentTensor(C.data(), TangentLayout::Packed), std::logic_error);
+}
+} // namespace
+
+int main() {
+  testElasticSweeps();
+  testCaching();
+  testPlasticSweeps();
+  testBucketing();
+  testPackedRejected();
+  return testResult();
+}
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Status tracking and local substepping of the batches: failed points are reset and report the response of their
+// converged state on every evaluate path, substepped points reach the result of the plain update.
+
+#include "testing.hh"
+
+#include <jlmuesli/finitestrain/finitestrainbatch.hh>
+#include <jlmuesli/smallstrain/smallstrainbatch.hh>
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <muesli/muesli.h>
+
+namespace {
+constexpr double E     = 210000.0;
+constexpr double nu    = 0.3;
+constexpr double rho   = 1.0;
+constexpr double yield = 250.0;
+constexpr double nan   = std::numeric_limits<double>::quiet_NaN();
+
+const muesli::splasticMaterial splastic{"Splastic", E, nu, rho, 1000.0, 0.0, yield, 0.0, "mises"};
+
+// Uniaxial strain of x yield strains for all n points
+std::vector<double> uniaxial(std::size_t n, double x) {
+  std::vector<double> strain(6 * n, 0.0);
+  for (std::size_t i = 0; i < n; ++i)
+    strain[6 * i] = x * yield / E;
+  return strain;
+}
+
+// Commits a first step, then evaluates a second one in which point 1 gets a NaN strain. Point 1 has to fail and
+// report the response of the first step, the others the response of the second one.
+template <typename Batch>
+void checkFailedPoint(Batch& batch) {
+  const std::size_t n = batch.size();
+  batch.setStatusTracking(true);
+  std::vector<double> first(6 * n), second(6 * n), C1(36 * n), C2(36 * n), energy1(n), energy2(n);
+  batch.evaluate(0.5, uniaxial(n, 0.5).data(), first.data(), 6, C1.data(), TangentLayout::Voigt, energy1.data());
+  batch.commitCurrentState();
+
+  std::vector<double> strain = uniaxial(n, 3.0);
+  strain[6 * 1 + 3]          = nan;
+  batch.evaluate(1.0, strain.data(), second.data(), 6, C2.data(), TangentLayout::Voigt, energy2.data());
+
+  CHECK(batch.status()[0] == PS_CONVERGED && batch.status()[2] == PS_CONVERGED);
+  CHECK(batch.status()[1] == PS_NON_FINITE);
+  CHECK(batch.statusSummary().failures() == 1);
+  for (std::size_t a = 0; a < 6; ++a)
+    CHECK_NEAR(second[6 * 1 + a], first[6 * 1 + a], 1e-12);
+  for (std::size_t m = 0; m < 36; ++m)
+    CHECK_NEAR(C2[36 * 1 + m], C1[36 * 1 + m], 1e-12);
+  CHECK_NEAR(energy2[1], energy1[1], 1e-12);
+  CHECK(second[0] > first[0]);
+
+  // The failed point was reset, its stress is that of the converged step as well
+  std::vector<double> stress(6 * n);
+  batch.stress(stress.data(), 6);
+  for (std::size_t a = 0; a < 6; ++a)
+    CHECK_NEAR(stress[6 * 1 + a], first[6 * 1 + a], 1e-12);
+}
+
+void testFailedPoints() {
+  const muesli::elasticIsotropicMaterial elastic{"ElasticIsotropic", E, nu, rho};
+  using ElasticBatch = SmallStrainMPBatch<muesli::elasticIsotropicMaterial, muesli::elasticIsotropicMP>;
+  ElasticBatch plain(elastic, 3);
+  plain.setSimdKernel(false);
+  checkFailedPoint(plain);
+  ElasticBatch kernel(elastic, 3);
+  if (kernel.simdKernel())
+    checkFailedPoint(kernel);
+
+  using PlasticBatch = SmallStrainMPBatch<muesli::splasticMaterial, muesli::splasticMP>;
+  PlasticBatch plastic(splastic, 3);
+  checkFailedPoint(plastic);
+  PlasticBatch bucketed(splastic, 3);
+  bucketed.setBucketing(true);
+  checkFailedPoint(bucketed);
+}
+
+void testNegativeJacobian() {
+  const muesli::neohookeanMaterial material{"NeoHooke", E, nu, rho};
+  FiniteStrainMPBatch<muesli::neohookeanMaterial, muesli::neohookeanMP> batch(material, 2), virgin(material, 2);
+  batch.setStatusTracking(true);
+  const double F[18] = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, -1.0, 1.01, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+  std::vector<double> S(12), C(72), energy(2), C0(72);
+  batch.evaluate(1.0, F, S.data(), 6, C.data(), TangentLayout::Voigt, energy.data());
+  virgin.convectedTangent(C0.data(), TangentLayout::Voigt);
+
+  CHECK(batch.status()[0] == PS_NEGATIVE_JACOBIAN);
+  CHECK(batch.status()[1] == PS_CONVERGED);
+  for (std::size_t a = 0; a < 6; ++a)
+    CHECK_NEAR(S[a], 0.0, 1e-12);
+  for (std::size_t m = 0; m < 36; ++m)
+    CHECK_NEAR(C[m], C0[m], 1e-12);
+  CHECK(S[6] > 0.0);
+}
+
+void testSubstepping() {
+  // Point 0 takes a large increment and is split by the increment limit, the others stay elastic. With linear
+  // hardening under proportional loading the substeps reach the result of the single update.
+  const std::size_t n = 4;
+  SmallStrainMPBatch<muesli::splasticMaterial, muesli::splasticMP> substepped(splastic, n), plain(splastic, n);
+  substepped.setStatusTracking(true);
+  substepped.setSubstepping(4, 0.5);
+  CHECK(substepped.substepping());
+
+  std::vector<double> strain = uniaxial(n, 0.1);
+  strain[0]                  = 5.0 * yield / E;
+  std::vector<double> sigma(6 * n), C(36 * n), energy(n), sigmaP(6 * n), CP(36 * n), energyP(n);
+  substepped.evaluate(1.0, strain.data(), sigma.data(), 6, C.data(), TangentLayout::Voigt, energy.data());
+  plain.evaluate(1.0, strain.data(), sigmaP.data(), 6, CP.data(), TangentLayout::Voigt, energyP.data());
+
+  CHECK(substepped.substeps()[0] > 1);
+  for (std::size_t i = 1; i < n; ++i)
+    CHECK(substepped.substeps()[i] == 1);
+  const SubstepStatistics statistics = substepped.substepStatistics();
+  CHECK(statistics.points == 1);
+  CHECK(statistics.unrecovered == 0);
+  CHECK(substepped.statusSummary().failures() == 0);
+  for (std::size_t m = 0; m < sigma.size(); ++m)
+    CHECK_NEAR(sigma[m], sigmaP[m], 1e-8);
+
+  // Committing and resetting keep working on the substepped points
+  substepped.commitCurrentState();
+  substepped.updateCurrentState(2.0, uniaxial(n, 6.0).data(), 6);
+  substepped.resetCurrentState();
+  std::vector<double> stress(6 * n);
+  substepped.stress(stress.data(), 6);
+  for (std::size_t m = 0; m < stress.size(); ++m)
+    CHECK_NEAR(stress[m], sigma[m], 1e-12);
+
+  substepped.setSubstepping(0);
+  CHECK(!substepped.substepping());
+
+  // The increment limit needs a yield strain
+  const muesli::elasticIsotropicMaterial elastic{"ElasticIsotropic", E, nu, rho};
+  SmallStrainMPBatch<muesli::elasticIsotropicMaterial, muesli::elasticIsotropicMP> batch(elastic, 1);
+  CHECK_THROWS(batch.setSubstepping(2, 0.5), std::logic_error);
+  CHECK_THROWS(substepped.setSubstepping(2, -1.0), std::invalid_argument);
+}
+} // namespace
+
+int main() {
+  testFailedPoints();
+  testNegativeJacobian();
+  testSubstepping();
+  return testResult();
+}
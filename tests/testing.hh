@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2025 Henrik Jakob jakob@ibb.uni-stuttgart.de
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+// Minimal checks for the unit tests. A failed check is reported with its location and counted, every test executable
+// returns testResult() from main so that ctest sees the failures.
+
+inline std::size_t& testFailures() {
+  static std::size_t failures = 0;
+  return failures;
+}
+
+inline void reportFailure(const char* file, int line, const std::string& message) {
+  ++testFailures();
+  std::cerr << file << ":" << line << ": " << message << "\n";
+}
+
+// Whether a and b agree up to tolerance relative to the larger of them (absolute below 1)
+inline bool near(double a, double b, double tolerance) {
+  return std::abs(a - b) <= tolerance * std::max({1.0, std::abs(a), std::abs(b)});
+}
+
+inline int testResult() {
+  if (testFailures() > 0)
+    std::cerr << testFailures() << " check(s) failed\n";
+  return testFailures() == 0 ? 0 : 1;
+}
+
+#define CHECK(condition)                                                                                               \
+  do {                                                                                                                 \
+    if (!(condition))                                                                                                  \
+      reportFailure(__FILE__, __LINE__, "CHECK(" #condition ") failed");                                               \
+  } while (false)
+
+#define CHECK_NEAR(a, b, tolerance)                                                                                    \
+  do {                                                                                                                 \
+    const double checkA = (a), checkB = (b);                                                                           \
+    if (!near(checkA, checkB, tolerance))                                                                              \
+      reportFailure(__FILE__, __LINE__,                                                                                \
+                    "CHECK_NEAR(" #a ", " #b ") failed: " + std::to_string(checkA) + " != " + std::to_string(checkB)); \
+  } while (false)
+
+#define CHECK_THROWS(expression, Exception)                                                                            \
+  do {                                                                                                                 \
+    bool checkThrown = false;                                                                                          \
+    try {                                                                                                              \
+      expression;                                                                                                      \
+    } catch (const Exception&) {                                                                                       \
+      checkThrown = true;                                                                                              \
+    }                                                                                                                  \
+    if (!checkThrown)                                                                                                  \
+      reportFailure(__FILE__, __LINE__, "CHECK_THROWS(" #expression ", " #Exception ") did not throw");                \
+  } while (false)